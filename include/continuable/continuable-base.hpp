@@ -35,8 +35,10 @@
 #include <cstddef>
 #include <type_traits>
 #include <utility>
+#include <continuable/continuable-cancellation.hpp>
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/continuable-result.hpp>
+#include <continuable/continuable-shared.hpp>
 #include <continuable/detail/connection/connection-all.hpp>
 #include <continuable/detail/connection/connection-any.hpp>
 #include <continuable/detail/connection/connection-seq.hpp>
@@ -448,6 +450,43 @@ public:
         std::forward<E>(executor));
   }
 
+  /// Attaches the given cancellation_token to the continuation chain.
+  ///
+  /// Once the cancellation was requested through the corresponding
+  /// cancellation_source, all callbacks of the chain which weren't invoked yet
+  /// are skipped and the chain is resolved through a cancellation
+  /// (a default constructed exception_t) instead.
+  /// Continuations which weren't started yet aren't invoked at all,
+  /// while promises of started ones can query the cancellation through
+  /// promise_base::is_cancelled in order to stop their work early:
+  /// ```cpp
+  /// cti::cancellation_source source;
+  ///
+  /// http_request("github.com")
+  ///   .then([](std::string content) {
+  ///     // Not called when the source was cancelled before
+  ///   })
+  ///   .with_cancellation(source.token())
+  ///   .fail([](cti::exception_t e) {
+  ///     // Called with a default constructed exception_t on cancellation
+  ///   });
+  ///
+  /// source.cancel();
+  /// ```
+  ///
+  /// \param token The token which observes the cancellation.
+  ///
+  /// \returns Returns a continuable_base of the same type.
+  ///
+  /// \note When multiple tokens are attached to a chain, each callback
+  ///       observes the token which was attached closest after it.
+  ///
+  /// \since 4.3.0
+  auto with_cancellation(detail::cancellation::cancellation_token token) && {
+    return detail::base::attach_cancellation(std::move(*this).finish(),
+                                             std::move(token));
+  }
+
   /// Returns a continuable_base which will have its signature converted
   /// to the given Args.
   ///
@@ -480,6 +519,33 @@ public:
     return std::forward<T>(transform)(std::move(*this).finish());
   }
 
+  /// Converts this continuable into a copyable cti::shared_continuable,
+  /// which makes it possible to attach multiple consumers to its result.
+  ///
+  /// ```cpp
+  /// cti::shared_continuable<int> shared = http_request("example.com")
+  ///                                           .then([](std::string page) {
+  ///                                             return page.size();
+  ///                                           })
+  ///                                           .share();
+  ///
+  /// shared.then([](int size) {
+  ///   // ...
+  /// });
+  /// shared.then([](int size) {
+  ///   // ...
+  /// });
+  /// ```
+  ///
+  /// \returns Returns a shared_continuable which starts this continuation
+  ///          when the first consumer is attached to it, and caches
+  ///          its result for the consumers which are attached later.
+  ///
+  /// \since 4.3.0
+  auto share() && {
+    return detail::operations::share(std::move(*this).finish());
+  }
+
   /// The pipe operator | is an alias for the continuable::then method.
   ///
   /// \param right The argument on the right-hand side to connect.
@@ -563,6 +629,8 @@ public:
   /// \note The continuable_base objects are invoked all at once,
   ///       however, the callback is only called once with
   ///       the first result or exception which becomes available.
+  ///       The remaining continuable_base objects run to completion,
+  ///       use cti::when_any_cancel to cancel them instead.
   ///
   /// \since 1.0.0
   template <typename OData, typename OAnnotation>
@@ -748,6 +816,11 @@ public:
   /// | `continuable_base with <Arg>`     | `result<Arg>`                      |
   /// | `continuable_base with <Args...>` | `result<Args...>`                  |
   ///
+  /// Awaiting an all connection such as `a && b` resumes the coroutine
+  /// when all continuations were resolved, or on the first error
+  /// like cti::when_all, while the remaining continuations are
+  /// settled in the background.
+  ///
   /// \note  Using continuable_base as return type for coroutines
   ///        is supported. The coroutine is initially stopped and
   ///        resumed when the continuation is requested in order to
@@ -777,7 +850,7 @@ public:
   ///
   /// \since     2.0.0
   auto operator co_await() && {
-    return detail::awaiting::create_awaiter(std::move(*this).finish());
+    return detail::awaiting::create_awaiter(std::move(*this));
   }
   /// \cond false
 #endif // defined(CONTINUABLE_HAS_COROUTINE)
@@ -0,0 +1,91 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_CANCELLATION_HPP_INCLUDED
+#define CONTINUABLE_CANCELLATION_HPP_INCLUDED
+
+#include <continuable/detail/core/cancellation.hpp>
+
+namespace cti {
+/// \defgroup Cancellation Cancellation
+/// provides the \link cti::cancellation_source cancellation_source\endlink
+/// and \link cti::cancellation_token cancellation_token\endlink
+/// for cancelling asynchronous chains which are in flight.
+/// \{
+
+/// Observes whether the cancellation of a chain was requested through
+/// its cancellation_source.
+///
+/// A token is attached to a chain through
+/// continuable_base::with_cancellation. Afterwards the callbacks chained in
+/// front of the token are skipped once the cancellation was requested,
+/// and promises can query it through promise_base::is_cancelled:
+/// ```cpp
+/// cti::make_continuable<std::string>([](auto&& promise) {
+///   for (auto&& chunk : chunks) {
+///     if (promise.is_cancelled()) {
+///       // Nobody will consume the result anymore
+///       return promise.set_canceled();
+///     }
+///     // ...
+///   }
+/// });
+/// ```
+///
+/// A default constructed token is never cancelled.
+/// Tokens are cheap to copy since they share the state with their source.
+///
+/// \since 4.3.0
+using cancellation_token = detail::cancellation::cancellation_token;
+
+/// Requests the cancellation of all chains which are observing one of
+/// its cancellation_token objects.
+///
+/// ```cpp
+/// cti::cancellation_source source;
+///
+/// auto chain = http_request("github.com")
+///   .with_cancellation(source.token());
+///
+/// // When the user drops interest in the result
+/// source.cancel();
+/// ```
+///
+/// \note The cancellation is cooperative, an asynchronous operation which
+///       already was started is only stopped when its promise queries
+///       the cancellation. In any case its result is dropped and
+///       the chain is resolved through a default constructed exception_t.
+///
+/// \since 4.3.0
+using cancellation_source = detail::cancellation::cancellation_source;
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_CANCELLATION_HPP_INCLUDED
@@ -0,0 +1,129 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_CHANNEL_HPP_INCLUDED
+#define CONTINUABLE_CHANNEL_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <continuable/continuable-base.hpp>
+#include <continuable/detail/other/channel.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
+
+namespace cti {
+/// \ingroup Primitives
+/// \{
+
+/// A bounded asynchronous channel which passes values from multiple
+/// producers to multiple consumers.
+///
+/// The values are stored in a lock-free ring buffer of a fixed capacity.
+/// A sender is parked when the buffer is full until a receiver takes a value
+/// out of it, and a receiver is parked when the buffer is empty until a
+/// sender passes a value to it, which applies back-pressure on the producers:
+/// ```cpp
+/// cti::channel<std::string> lines(64);
+///
+/// // Producer
+/// lines.send("hello").then([] {
+///   // The line was passed to the channel
+/// });
+///
+/// // Consumer
+/// lines.receive().then([](std::string line) {
+///   // ...
+/// });
+/// ```
+///
+/// The channel is a copyable handle to its shared state, parked senders and
+/// receivers are resolved through a cancellation when the last handle
+/// and the last unresolved continuable of the channel were destroyed.
+///
+/// \tparam T The type of the values which are passed through the channel,
+///           its move constructor shall not throw.
+///
+/// \since 4.3.0
+template <typename T>
+class channel {
+  using state_t = detail::channel::channel_state<T>;
+
+  detail::util::ref_ptr<state_t> state_;
+
+public:
+  /// Creates a channel which buffers up to capacity values.
+  ///
+  /// \note A capacity of zero is treated as one, since the channel
+  ///       always passes values through its buffer.
+  explicit channel(std::size_t capacity)
+      : state_(detail::util::make_ref<state_t>(
+            (std::max)(capacity, std::size_t(1U)))) {
+  }
+
+  channel(channel const&) = default;
+  channel(channel&&) = default;
+  channel& operator=(channel const&) = default;
+  channel& operator=(channel&&) = default;
+
+  /// Returns the count of values the channel can buffer
+  std::size_t capacity() const noexcept {
+    return state_->capacity();
+  }
+
+  /// Returns a continuable_base which passes the given value to the
+  /// channel when it's invoked.
+  ///
+  /// \returns A continuable_base without arguments which is resolved when
+  ///          the value was stored in the buffer of the channel,
+  ///          or when it was passed to a parked receiver.
+  auto send(T value) const {
+    return make_continuable<void>(
+        [state = state_, value = std::move(value)](auto&& promise) mutable {
+          state->send(std::forward<decltype(promise)>(promise),
+                      std::move(value));
+        });
+  }
+
+  /// Returns a continuable_base which takes the next value out of
+  /// the channel when it's invoked.
+  ///
+  /// \returns A continuable_base which is resolved with the next value
+  ///          of the channel, values are received in the order they
+  ///          were stored in the buffer.
+  auto receive() const {
+    return make_continuable<T>([state = state_](auto&& promise) {
+      state->receive(std::forward<decltype(promise)>(promise));
+    });
+  }
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_CHANNEL_HPP_INCLUDED
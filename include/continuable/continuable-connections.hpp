@@ -33,10 +33,12 @@
 
 #include <initializer_list>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <continuable/detail/connection/connection-all.hpp>
 #include <continuable/detail/connection/connection-any.hpp>
+#include <continuable/detail/connection/connection-each.hpp>
 #include <continuable/detail/connection/connection-seq.hpp>
 #include <continuable/detail/connection/connection.hpp>
 #include <continuable/detail/traversal/range.hpp>
@@ -190,6 +192,9 @@ auto when_seq(Iterator begin, Iterator end) {
 /// invoked at once. On completion of one continuable the final handler
 /// is called with the result of the resolved continuable.
 ///
+/// The remaining continuables run to completion and their results are
+/// dropped, use when_any_cancel in order to cancel them instead.
+///
 /// \param args Arbitrary arguments which are connected.
 ///             Every type is allowed as arguments, continuables may be
 ///             contained inside tuple like types (`std::tuple`)
@@ -253,6 +258,121 @@ auto when_any(Iterator begin, Iterator end) {
   return when_any(detail::range::persist_range(begin, end));
 }
 
+/// Connects the given arguments with an any logic like when_any, but cancels
+/// the remaining continuables as soon as the first result arrived.
+///
+/// The pending callbacks of the remaining continuables are skipped,
+/// continuables which weren't started yet aren't invoked and the promises
+/// of started ones report promise_base::is_cancelled, such that producers
+/// can abandon their work early:
+/// ```cpp
+/// cti::when_any_cancel(http_request("mirror-1.example.com"),
+///                      http_request("mirror-2.example.com"))
+///   .then([](std::string content) {
+///     // The slower request was cancelled
+///   });
+/// ```
+///
+/// \param args Arbitrary arguments which are connected,
+///             see when_any for details.
+///
+/// \note The cancellation is cooperative, side effects of callbacks which
+///       were invoked already aren't undone.
+///
+/// \since      4.3.0
+template <typename... Args>
+auto when_any_cancel(Args&&... args) {
+  return detail::connection::apply_connection(
+      detail::connection::connection_strategy_any_cancel_tag{},
+      std::forward<Args>(args)...);
+}
+
+/// Connects the given arguments with a cancelling any logic.
+/// The content of the iterator is moved out and converted
+/// to a temporary `std::vector` which is then passed to when_any_cancel.
+///
+/// \param begin The begin iterator to the range which will be moved out
+///              and used as the arguments to the connection
+///
+/// \param end   The end iterator to the range which will be moved out
+///              and used as the arguments to the connection
+///
+/// \see         when_any_cancel for details.
+///
+/// \since       4.3.0
+template <
+    typename Iterator,
+    std::enable_if_t<detail::range::is_iterator<Iterator>::value>* = nullptr>
+auto when_any_cancel(Iterator begin, Iterator end) {
+  return when_any_cancel(detail::range::persist_range(begin, end));
+}
+
+/// Starts all continuables of the given homogeneous container at once and
+/// passes the result of each one to the handler as soon as it arrived.
+///
+/// In contrast to cti::when_all the results aren't aggregated, which makes it
+/// possible to process early results while other continuables are still
+/// outstanding, and the memory which is required doesn't grow with the
+/// count of results:
+/// ```cpp
+/// std::vector<cti::continuable<std::string>> requests = /* ... */;
+///
+/// cti::when_each(std::move(requests), [](std::string response) {
+///   // Called once for every response, in the order of arrival
+/// })
+///   .then([] {
+///     // All responses were handled
+///   });
+/// ```
+///
+/// The returned continuable is resolved after all continuables completed.
+/// The first exception, including the ones thrown by the handler, cancels the
+/// continuables which didn't complete yet as described in
+/// cti::when_any_cancel, no further results are passed to the handler afterwards and the
+/// returned continuable is resolved with the exception.
+///
+/// \param container A homogeneous container such as `std::vector`
+///                  which contains the continuables to start.
+///
+/// \param handler The handler which is invoked with the result of
+///                each continuable.
+///
+/// \attention The handler is invoked on the thread the corresponding
+///            continuable is resolved on, hence it needs to be thread-safe
+///            when the continuables are resolved concurrently.
+///
+/// \since     4.3.0
+template <typename Container, typename Handler,
+          std::enable_if_t<!detail::range::is_iterator<
+              std::decay_t<Container>>::value>* = nullptr>
+auto when_each(Container&& container, Handler&& handler) {
+  return detail::connection::each::when_each(
+      std::forward<Container>(container), std::forward<Handler>(handler));
+}
+
+/// Starts all continuables of the given range at once and passes the result
+/// of each one to the handler as soon as it arrived.
+/// The content of the iterator is moved out and converted
+/// to a temporary `std::vector` which is then passed to when_each.
+///
+/// \param begin The begin iterator to the range which will be moved out
+///
+/// \param end   The end iterator to the range which will be moved out
+///
+/// \param handler The handler which is invoked with the result of
+///                each continuable.
+///
+/// \see         when_each for details.
+///
+/// \since       4.3.0
+template <
+    typename Iterator, typename Handler,
+    std::enable_if_t<detail::range::is_iterator<Iterator>::value>* = nullptr>
+auto when_each(Iterator begin, Iterator end, Handler&& handler) {
+  return when_each(detail::range::persist_range(begin, end),
+                   std::forward<Handler>(handler));
+}
+
 /// Populates a homogeneous container from the given arguments.
 /// All arguments need to be convertible to the first one,
 /// by default `std::vector` is used as container type.
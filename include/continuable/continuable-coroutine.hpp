@@ -30,6 +30,8 @@
 #ifndef CONTINUABLE_COROUTINE_HPP_INCLUDED
 #define CONTINUABLE_COROUTINE_HPP_INCLUDED
 
+#include <type_traits>
+#include <utility>
 #include <continuable/continuable-base.hpp>
 #include <continuable/continuable-types.hpp>
 #include <continuable/detail/core/types.hpp>
@@ -70,6 +72,64 @@ namespace cti {
 /// \since 4.1.0
 using await_canceled_exception = detail::awaiting::await_canceled_exception;
 #  endif // CONTINUABLE_HAS_EXCEPTIONS
+
+/// Awaits the given continuable_base inside a coroutine and resumes it with
+/// the cti::result of the continuation, rather than with its values.
+///
+/// In contrast to a plain co_await expression an exception or a
+/// cancellation of the continuation isn't rethrown, which avoids the
+/// cost of unwinding for expected failures, and makes it possible to
+/// handle errors in coroutines when exceptions are disabled:
+/// ```cpp
+/// cti::continuable<std::string> fetch_or_default() {
+///   cti::result<std::string> page =
+///       co_await cti::as_result(http_request("example.com"));
+///
+///   if (page.is_value()) {
+///     co_return std::move(page).get_value();
+///   }
+///   co_return std::string{};
+/// }
+/// ```
+///
+/// \returns An awaitable which resumes the coroutine with a
+///          cti::result<Args...> that is never empty.
+///
+/// \since 4.3.0
+template <typename Data, typename Annotation>
+auto as_result(continuable_base<Data, Annotation>&& continuable) {
+  return detail::awaiting::create_result_awaiter(
+      std::move(continuable).finish());
+}
+
+/// Suspends the coroutine and resumes it through the given executor,
+/// which makes it possible to switch the thread inside a coroutine:
+/// ```cpp
+/// cti::continuable<std::size_t> count_words(cti::thread_pool& pool) {
+///   std::string text = co_await read_file("text.txt");
+///
+///   // Continue on a thread of the pool
+///   co_await cti::resume_on(pool.executor());
+///
+///   co_return count_words_of(text);
+/// }
+/// ```
+///
+/// In contrast to awaiting an empty cti::async_on, no continuable is created,
+/// the work which is passed to the executor stores the handle to
+/// the suspended coroutine only.
+/// When the executor drops the work, or resolves it with an exception,
+/// the co_await expression rethrows it as it would for a continuable.
+///
+/// \param executor The executor which is invoked with a work object
+///                 that resumes the coroutine.
+///
+/// \since 4.3.0
+template <typename Executor>
+auto resume_on(Executor&& executor) {
+  return detail::awaiting::resume_on_awaitable<std::decay_t<Executor>>(
+      std::forward<Executor>(executor));
+}
 } // namespace cti
 
 /// \cond false
@@ -85,7 +145,8 @@ struct coroutine_traits<
     FunctionArgs...> {
 
   using promise_type = cti::detail::awaiting::promise_type<
-      cti::continuable<Args...>, cti::promise<Args...>, Args...>;
+      cti::continuable<Args...>, cti::promise<Args...>,
+      cti::detail::awaiting::frame_base_of<FunctionArgs...>, Args...>;
 };
 #  if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
 } // namespace experimental
@@ -0,0 +1,185 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_FUTURE_HPP_INCLUDED
+#define CONTINUABLE_FUTURE_HPP_INCLUDED
+
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <utility>
+#include <continuable/continuable-result.hpp>
+#include <continuable/detail/core/base.hpp>
+#include <continuable/detail/transforms/future.hpp>
+#include <continuable/detail/transforms/wait.hpp>
+#include <continuable/detail/utility/identity.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+namespace cti {
+/// \ingroup Transforms
+/// \{
+
+/// A lightweight future which receives the result of a continuable_base,
+/// it's created through cti::transforms::to_cti_future.
+///
+/// The result is stored inside a single allocation together with an
+/// atomic state word, hence cti::future::is_ready can be polled
+/// without a lock, and waiting threads are blocked on the state word
+/// directly. In contrast to `std::future` the arguments aren't boxed into a
+/// `std::tuple`, and the future can be converted back into a
+/// continuable_base:
+/// ```cpp
+/// cti::future<int> future = http_request("example.com")
+///                               .then([](std::string page) {
+///                                 return page.size();
+///                               })
+///                               .apply(cti::transforms::to_cti_future());
+///
+/// // ...
+///
+/// std::move(future).to_continuable().then([](int size) {
+///   // ...
+/// });
+/// ```
+///
+/// \tparam Args The arguments the future is resolved with
+///
+/// \since 4.3.0
+template <typename... Args>
+class future {
+  using state_t = detail::transforms::future_state<Args...>;
+
+  detail::util::ref_ptr<state_t> state_;
+
+public:
+  /// Constructs a future without a shared state, which isn't valid
+  future() = default;
+  /// Constructs the future from its shared state
+  explicit future(detail::util::ref_ptr<state_t> state) noexcept
+      : state_(std::move(state)) {
+  }
+
+  future(future const&) = delete;
+  future(future&&) = default;
+  future& operator=(future const&) = delete;
+  future& operator=(future&&) = default;
+
+  /// Returns true if the future refers to a shared state
+  bool valid() const noexcept {
+    return bool(state_);
+  }
+
+  /// Returns true if the result is available, which never blocks
+  bool is_ready() const noexcept {
+    assert(valid());
+    return state_->is_ready();
+  }
+
+  /// Blocks until the result is available
+  void wait() const {
+    assert(valid());
+    state_->wait();
+  }
+
+  /// Blocks until the result is available or the given duration passed
+  ///
+  /// \returns `std::future_status::ready` if the result is available,
+  ///          `std::future_status::timeout` otherwise.
+  template <typename Rep, typename Period>
+  std::future_status
+  wait_for(std::chrono::duration<Rep, Period> const& duration) const {
+    assert(valid());
+    if (state_->is_ready()) {
+      return std::future_status::ready;
+    }
+    return wait_until(std::chrono::steady_clock::now() + duration);
+  }
+
+  /// Blocks until the result is available or the given time point passed
+  ///
+  /// \returns `std::future_status::ready` if the result is available,
+  ///          `std::future_status::timeout` otherwise.
+  template <typename Clock, typename Duration>
+  std::future_status
+  wait_until(std::chrono::time_point<Clock, Duration> const& deadline) const {
+    assert(valid());
+    return state_->wait_until(deadline) ? std::future_status::ready
+                                        : std::future_status::timeout;
+  }
+
+  /// Blocks until the result is available and returns it,
+  /// the future isn't valid anymore afterwards.
+  ///
+  /// \returns The value depends on the arguments of the future:
+  /// |    Future type   |       Return type     |
+  /// | : -------------- | : ------------------- |
+  /// | `future<>`       | `void`                |
+  /// | `future<Arg>`    | `Arg`                 |
+  /// | `future<Args...>`| `std::tuple<Args...>` |
+  ///
+  /// \throws The exception the future was resolved with or a
+  ///         transforms::wait_transform_canceled_exception if the
+  ///         continuable_base was cancelled.
+  ///
+  /// \attention If exceptions are disabled the cti::result is returned.
+  auto get() {
+    assert(valid());
+    auto state = std::move(state_);
+    return detail::transforms::unpack_sync_result(state->take());
+  }
+
+  /// Blocks until the result is available and returns it as cti::result,
+  /// the future isn't valid anymore afterwards.
+  result<Args...> get_result() {
+    assert(valid());
+    auto state = std::move(state_);
+    return state->take();
+  }
+
+  /// Converts the future back into a continuable_base which is resolved
+  /// with the result of the future, the future isn't valid anymore
+  /// afterwards.
+  ///
+  /// The continuable_base is resolved on the thread which resolves the
+  /// future, or immediately when the result is available already.
+  auto to_continuable() && {
+    assert(valid());
+    return detail::base::attorney::create_from(
+        [state = std::move(state_)](auto&& promise) mutable {
+          state->attach(std::forward<decltype(promise)>(promise));
+        },
+        detail::identity<Args...>{}, detail::util::ownership{});
+  }
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_FUTURE_HPP_INCLUDED
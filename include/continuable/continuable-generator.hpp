@@ -0,0 +1,188 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_GENERATOR_HPP_INCLUDED
+#define CONTINUABLE_GENERATOR_HPP_INCLUDED
+
+#include <type_traits>
+#include <utility>
+#include <continuable/continuable-coroutine.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/features.hpp>
+
+#if defined(CONTINUABLE_HAS_COROUTINE)
+#  include <continuable/detail/other/generator.hpp>
+
+namespace cti {
+/// \ingroup Types
+/// \{
+
+/// A lazy coroutine type which produces a sequence of values asynchronously
+/// through co_yield, while it can await continuables through co_await.
+///
+/// The generator is resumed by its consumer for every value it requests
+/// through async_generator::next, and is suspended on every co_yield
+/// until the next value is requested. Hence a slow consumer suspends the
+/// producer, and no values are buffered:
+/// ```cpp
+/// cti::async_generator<page> fetch_pages(std::string url) {
+///   while (!url.empty()) {
+///     page current = co_await http_request(url);
+///     url = current.next_url;
+///     co_yield std::move(current);
+///   }
+/// }
+///
+/// cti::continuable<> print_pages() {
+///   auto pages = fetch_pages("example.com");
+///   for (;;) {
+///     cti::result<page> current = co_await pages.next();
+///     if (current.is_empty()) {
+///       co_return;
+///     }
+///     print(current.get_value());
+///   }
+/// }
+/// ```
+///
+/// The values of a generator can be consumed outside of a coroutine
+/// through cti::for_each.
+///
+/// \tparam T The type of the values which are yielded by the generator
+///
+/// \since 4.3.0
+template <typename T>
+class async_generator {
+  using handle_t = detail::awaiting::coroutine_handle<>;
+  using state_t = detail::awaiting::generator_state<T>;
+
+  handle_t handle_;
+  state_t* state_ = nullptr;
+
+public:
+  /// Constructs the generator from the handle of its suspended coroutine
+  /// and the state inside of its promise.
+  explicit async_generator(handle_t handle, state_t* state) noexcept
+    : handle_(handle), state_(state) {}
+  /// Destroys the coroutine of the generator, also if it's suspended
+  /// on a co_yield expression.
+  ~async_generator() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  async_generator(async_generator const&) = delete;
+  async_generator(async_generator&& other) noexcept
+    : handle_(std::exchange(other.handle_, {})), state_(other.state_) {}
+  async_generator& operator=(async_generator const&) = delete;
+  async_generator& operator=(async_generator&& other) noexcept {
+    async_generator(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  /// Swaps this generator with the given one
+  void swap(async_generator& other) noexcept {
+    std::swap(handle_, other.handle_);
+    std::swap(state_, other.state_);
+  }
+
+  /// Returns true when the generator wasn't moved away
+  bool is_valid() const noexcept {
+    return bool(handle_);
+  }
+
+  /// Resumes the generator until it yields its next value.
+  ///
+  /// \returns An awaitable which resumes the awaiting coroutine with a
+  ///          cti::result<T> that holds the next value, the exception
+  ///          the generator failed with, or which is empty when
+  ///          the generator has finished.
+  ///
+  /// \attention The generator must outlive the co_await expression,
+  ///            and the next value must not be requested before the
+  ///            previous one arrived.
+  auto next() noexcept {
+    return detail::awaiting::next_awaitable<T>(handle_, state_);
+  }
+};
+
+/// Consumes all values of the given async_generator by passing those to
+/// the given callable, which makes it possible to consume a generator
+/// outside of a coroutine:
+/// ```cpp
+/// cti::for_each(read_chunks("file.bin"), [&](std::vector<char> chunk) {
+///   return write_chunk(std::move(chunk));
+/// }).then([] {
+///   // All chunks were written
+/// });
+/// ```
+///
+/// \param generator The generator which is consumed, it's started when
+///                  the returned continuable is invoked.
+///
+/// \param callable The callable which is invoked with every value. When it
+///                 returns a continuable_base, the next value is requested
+///                 after the continuable_base was resolved.
+///
+/// \returns A continuable which is resolved when the generator finished,
+///          or which is resolved with the exception the generator or
+///          a continuable_base returned by the callable failed with.
+///
+/// \since 4.3.0
+template <typename T, typename Callable>
+continuable<> for_each(async_generator<T> generator, Callable&& callable) {
+  return detail::awaiting::for_each<continuable<>>(
+      std::move(generator),
+      std::decay_t<Callable>(std::forward<Callable>(callable)));
+}
+/// \}
+} // namespace cti
+
+/// \cond false
+// NOLINTNEXTLINE(cert-dcl58-cpp)
+namespace std {
+#  if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+namespace experimental {
+#  endif // defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+template <typename T, typename... FunctionArgs>
+struct coroutine_traits<cti::async_generator<T>, FunctionArgs...> {
+  using promise_type = cti::detail::awaiting::generator_promise<
+      cti::async_generator<T>,
+      cti::detail::awaiting::frame_base_of<FunctionArgs...>, T>;
+};
+#  if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+} // namespace experimental
+#  endif // defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+} // namespace std
+/// \endcond
+#endif // defined(CONTINUABLE_HAS_COROUTINE)
+
+#endif // CONTINUABLE_GENERATOR_HPP_INCLUDED
@@ -0,0 +1,304 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_MUTEX_HPP_INCLUDED
+#define CONTINUABLE_MUTEX_HPP_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/other/locking.hpp>
+
+namespace cti {
+/// \ingroup Primitives
+/// \{
+
+/// An asynchronous mutex which passes its ownership to continuations
+/// instead of blocking the calling thread.
+///
+/// The mutex is acquired through a continuable which is resolved with
+/// a guard that owns the mutex until it is destroyed:
+/// ```cpp
+/// cti::async_mutex mutex;
+///
+/// mutex.lock().then([](cti::async_mutex::guard guard) {
+///   // The mutex is owned until the guard is destroyed
+/// });
+/// ```
+///
+/// Waiters are queued without any allocation of a lock and are resumed
+/// in the order they were queued, on the thread which unlocks the mutex.
+/// Waiters which are still queued when the mutex is destroyed are resolved
+/// through a cancellation.
+///
+/// \since 4.3.0
+class async_mutex {
+public:
+  /// The guard which owns the mutex
+  using guard =
+      detail::locking::basic_guard<async_mutex,
+                                   detail::locking::unlock_exclusive>;
+
+  async_mutex() = default;
+  ~async_mutex() = default;
+
+  async_mutex(async_mutex const&) = delete;
+  async_mutex(async_mutex&&) = delete;
+  async_mutex& operator=(async_mutex const&) = delete;
+  async_mutex& operator=(async_mutex&&) = delete;
+
+  /// Returns a continuable which is resolved with a guard
+  /// that owns the mutex.
+  ///
+  /// When the mutex isn't locked, it is acquired immediately and a ready
+  /// continuable is returned which doesn't allocate. Otherwise the mutex
+  /// is acquired when the returned continuable is invoked.
+  continuable<guard> lock() {
+    if (try_lock()) {
+      return make_ready_continuable(guard(*this, std::adopt_lock));
+    }
+
+    return make_continuable<guard>([this](auto&& promise) {
+      detail::locking::acquire_or_park<guard>(
+          *this, std::forward<decltype(promise)>(promise), true,
+          [this](detail::locking::lock_waiter* waiter) {
+            return state_.lock_or_enqueue(waiter);
+          });
+    });
+  }
+
+  /// Acquires the mutex and returns true, or returns false
+  /// when it is locked already.
+  bool try_lock() noexcept {
+    return state_.try_lock();
+  }
+
+  /// Unlocks the mutex, its ownership is passed to the next waiter
+  /// which is resumed on the current thread.
+  void unlock() {
+    if (detail::locking::lock_waiter* waiter = state_.unlock()) {
+      detail::locking::handoff_trampoline::resolve(&state_, waiter);
+    }
+  }
+
+private:
+  detail::locking::mutex_state state_;
+};
+
+/// An asynchronous counting semaphore which passes its counts
+/// to continuations instead of blocking the calling thread.
+///
+/// ```cpp
+/// cti::async_semaphore connections(8);
+///
+/// connections.acquire().then([](cti::async_semaphore::guard guard) {
+///   // One of the counts is owned until the guard is destroyed
+/// });
+/// ```
+///
+/// Waiters are resumed in the order they were queued. An acquisition or
+/// release only modifies an atomic count while the semaphore isn't
+/// exhausted, a short internal lock is only taken for queueing
+/// or dequeuing a waiter.
+///
+/// \since 4.3.0
+class async_semaphore {
+public:
+  /// The guard which owns a count of the semaphore
+  using guard =
+      detail::locking::basic_guard<async_semaphore,
+                                   detail::locking::release_count>;
+
+  /// Creates a semaphore which provides the given count
+  explicit async_semaphore(std::size_t count)
+      : state_(static_cast<std::ptrdiff_t>(count)) {
+  }
+  ~async_semaphore() = default;
+
+  async_semaphore(async_semaphore const&) = delete;
+  async_semaphore(async_semaphore&&) = delete;
+  async_semaphore& operator=(async_semaphore const&) = delete;
+  async_semaphore& operator=(async_semaphore&&) = delete;
+
+  /// Returns a continuable which is resolved with a guard
+  /// that owns a count of the semaphore.
+  ///
+  /// When a count is available, it is acquired immediately and a ready
+  /// continuable is returned which doesn't allocate. Otherwise a count
+  /// is acquired when the returned continuable is invoked.
+  continuable<guard> acquire() {
+    if (try_acquire()) {
+      return make_ready_continuable(guard(*this, std::adopt_lock));
+    }
+
+    return make_continuable<guard>([this](auto&& promise) {
+      detail::locking::acquire_or_park<guard>(
+          *this, std::forward<decltype(promise)>(promise), true,
+          [this](detail::locking::lock_waiter* waiter) {
+            return state_.acquire_or_enqueue(waiter);
+          });
+    });
+  }
+
+  /// Acquires a count and returns true, or returns false
+  /// when no count is available.
+  bool try_acquire() noexcept {
+    return state_.try_acquire();
+  }
+
+  /// Releases a count, which is passed to the next waiter
+  /// that is resumed on the current thread.
+  void release() {
+    if (detail::locking::lock_waiter* waiter = state_.release()) {
+      detail::locking::handoff_trampoline::resolve(&state_, waiter);
+    }
+  }
+
+private:
+  detail::locking::semaphore_state state_;
+};
+
+/// An asynchronous reader-writer mutex which passes its exclusive or
+/// shared ownership to continuations instead of blocking the calling thread.
+///
+/// ```cpp
+/// cti::async_shared_mutex mutex;
+///
+/// mutex.lock_shared().then([](cti::async_shared_mutex::shared_guard guard) {
+///   // Other readers may own the mutex concurrently
+/// });
+///
+/// mutex.lock().then([](cti::async_shared_mutex::guard guard) {
+///   // The mutex is owned exclusively
+/// });
+/// ```
+///
+/// Waiters are resumed in the order they were queued, a queued writer
+/// blocks all readers which arrive after it. An uncontended acquisition or
+/// release only modifies an atomic state, a short internal lock is only
+/// taken for queueing or dequeuing waiters.
+///
+/// \since 4.3.0
+class async_shared_mutex {
+public:
+  /// The guard which owns the mutex exclusively
+  using guard =
+      detail::locking::basic_guard<async_shared_mutex,
+                                   detail::locking::unlock_exclusive>;
+  /// The guard which shares the ownership of the mutex
+  using shared_guard =
+      detail::locking::basic_guard<async_shared_mutex,
+                                   detail::locking::unlock_shared>;
+
+  async_shared_mutex() = default;
+  ~async_shared_mutex() = default;
+
+  async_shared_mutex(async_shared_mutex const&) = delete;
+  async_shared_mutex(async_shared_mutex&&) = delete;
+  async_shared_mutex& operator=(async_shared_mutex const&) = delete;
+  async_shared_mutex& operator=(async_shared_mutex&&) = delete;
+
+  /// Returns a continuable which is resolved with a guard
+  /// that owns the mutex exclusively.
+  ///
+  /// \copydetails async_mutex::lock
+  continuable<guard> lock() {
+    if (try_lock()) {
+      return make_ready_continuable(guard(*this, std::adopt_lock));
+    }
+
+    return make_continuable<guard>([this](auto&& promise) {
+      detail::locking::acquire_or_park<guard>(
+          *this, std::forward<decltype(promise)>(promise), true,
+          [this](detail::locking::lock_waiter* waiter) {
+            return state_.lock_or_enqueue(waiter);
+          });
+    });
+  }
+
+  /// Returns a continuable which is resolved with a guard
+  /// that shares the ownership of the mutex.
+  ///
+  /// When the mutex isn't owned exclusively and no writer is queued, it is
+  /// acquired immediately and a ready continuable is returned which
+  /// doesn't allocate. Otherwise the mutex is acquired when the returned
+  /// continuable is invoked.
+  continuable<shared_guard> lock_shared() {
+    if (try_lock_shared()) {
+      return make_ready_continuable(shared_guard(*this, std::adopt_lock));
+    }
+
+    return make_continuable<shared_guard>([this](auto&& promise) {
+      detail::locking::acquire_or_park<shared_guard>(
+          *this, std::forward<decltype(promise)>(promise), false,
+          [this](detail::locking::lock_waiter* waiter) {
+            return state_.lock_or_enqueue(waiter);
+          });
+    });
+  }
+
+  /// Acquires the exclusive ownership and returns true,
+  /// or returns false when the mutex is owned already.
+  bool try_lock() noexcept {
+    return state_.try_lock();
+  }
+
+  /// Acquires a shared ownership and returns true, or returns false
+  /// when the mutex is owned exclusively or waiters are queued.
+  bool try_lock_shared() noexcept {
+    return state_.try_lock_shared();
+  }
+
+  /// Releases the exclusive ownership, which is passed to the next
+  /// waiters that are resumed on the current thread.
+  void unlock() {
+    detail::util::intrusive_queue<detail::locking::lock_waiter> acquired;
+    state_.unlock(acquired);
+    detail::locking::handoff_trampoline::resolve_all(&state_, acquired);
+  }
+
+  /// Releases a shared ownership, the exclusive ownership is passed to the
+  /// next waiter when the last reader released its ownership.
+  void unlock_shared() {
+    detail::util::intrusive_queue<detail::locking::lock_waiter> acquired;
+    state_.unlock_shared(acquired);
+    detail::locking::handoff_trampoline::resolve_all(&state_, acquired);
+  }
+
+private:
+  detail::locking::shared_mutex_state state_;
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_MUTEX_HPP_INCLUDED
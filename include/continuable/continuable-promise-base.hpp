@@ -36,6 +36,7 @@
 #include <utility>
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/detail/core/annotation.hpp>
+#include <continuable/detail/core/cancellation.hpp>
 #include <continuable/detail/core/types.hpp>
 #include <continuable/detail/utility/traits.hpp>
 #include <continuable/detail/utility/util.hpp>
@@ -70,6 +71,9 @@ class promise_base<Data, detail::identity<Args...>>
 { // clang-format on
 
   /// \cond false
+  // The cancellation state of the chain, which is captured before the
+  // callback is type erased into the data object.
+  detail::util::ref_ptr<detail::cancellation::cancellation_state> state_;
   // The callback type
   Data data_;
   /// \endcond
@@ -78,7 +82,10 @@ public:
   /// Constructor for constructing an empty promise
   explicit promise_base() = default;
   /// Constructor accepting the data object
-  explicit promise_base(Data data) : data_(std::move(data)) {
+  explicit promise_base(Data data)
+      : state_(detail::cancellation::share_state(
+            detail::cancellation::state_of(data))),
+        data_(std::move(data)) {
   }
 
   /// \cond false
@@ -93,7 +100,10 @@ public:
   template <typename OData,
             std::enable_if_t<std::is_convertible<
                 detail::traits::unrefcv_t<OData>, Data>::value>* = nullptr>
-  /* implicit */ promise_base(OData&& data) : data_(std::forward<OData>(data)) {
+  /* implicit */ promise_base(OData&& data)
+      : state_(detail::cancellation::share_state(
+            detail::cancellation::state_of(data))),
+        data_(std::forward<OData>(data)) {
   }
 
   /// Assignment operator accepting any object convertible to the data object
@@ -101,6 +111,8 @@ public:
             std::enable_if_t<std::is_convertible<
                 detail::traits::unrefcv_t<OData>, Data>::value>* = nullptr>
   promise_base& operator=(OData&& data) {
+    state_ = detail::cancellation::share_state(
+        detail::cancellation::state_of(data));
     data_ = std::forward<OData>(data);
     return *this;
   }
@@ -200,6 +212,29 @@ public:
     data_ = nullptr;
   }
 
+  /// Returns true when the cancellation of the chain which is continued
+  /// by this promise was requested through a cancellation_token.
+  ///
+  /// Producers can use this method in order to stop expensive work early,
+  /// when its result wouldn't be consumed anymore.
+  /// Resolving a cancelled promise is still valid, its result is dropped.
+  ///
+  /// \throws This method never throws an exception.
+  ///
+  /// \see continuable_base::with_cancellation
+  ///
+  /// \since  4.3.0
+  bool is_cancelled() const noexcept {
+    return state_ && state_->is_cancelled();
+  }
+
+  /// \cond false
+  detail::cancellation::cancellation_state*
+  get_cancellation_state() const noexcept {
+    return state_.get();
+  }
+  /// \endcond
+
   /// Returns true if the continuation is valid (non empty).
   ///
   /// \throws This method never throws an exception.
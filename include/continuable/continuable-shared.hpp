@@ -0,0 +1,172 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_SHARED_HPP_INCLUDED
+#define CONTINUABLE_SHARED_HPP_INCLUDED
+
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include <continuable/detail/core/base.hpp>
+#include <continuable/detail/core/types.hpp>
+#include <continuable/detail/operations/share.hpp>
+#include <continuable/detail/utility/identity.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+namespace cti {
+/// \ingroup Operations
+/// \{
+
+/// A copyable handle to the result of a continuable_base, which is
+/// created through continuable_base::share.
+///
+/// The underlying continuation is started once, when the first consumer is
+/// attached to any copy of the handle. Its result is cached inside the
+/// shared state, consumers which are attached after the result arrived are
+/// resolved immediately with it. The callbacks passed to then and next
+/// receive the cached result as const lvalue references, hence it's only
+/// copied when a callback takes its arguments by value, or when it requires
+/// rvalue references:
+/// ```cpp
+/// cti::shared_continuable<std::string> page =
+///     http_request("example.com").share();
+///
+/// page.then([](std::string const& content) {
+///   // ...
+/// });
+///
+/// // The request is sent only once
+/// page.then([](std::string const& content) {
+///   // ...
+/// });
+/// ```
+///
+/// \tparam Args The arguments the shared continuation is resolved with
+///
+/// \since 4.3.0
+template <typename... Args>
+class shared_continuable {
+  using state_t = detail::operations::shared_state<Args...>;
+
+  detail::util::ref_ptr<state_t> state_;
+
+public:
+  /// Constructs the shared_continuable from its shared state
+  explicit shared_continuable(detail::util::ref_ptr<state_t> state) noexcept
+      : state_(std::move(state)) {
+  }
+
+  shared_continuable(shared_continuable const&) = default;
+  shared_continuable(shared_continuable&&) = default;
+  shared_continuable& operator=(shared_continuable const&) = default;
+  shared_continuable& operator=(shared_continuable&&) = default;
+
+  /// Returns true if the result of the shared continuation is available,
+  /// which never blocks.
+  bool is_ready() const noexcept {
+    assert(state_);
+    return state_->is_ready();
+  }
+
+  /// Returns a continuable_base which is resolved with the shared result,
+  /// the shared continuation is started when the returned continuable_base
+  /// is invoked for the first time.
+  auto to_continuable() const {
+    assert(state_);
+    return detail::base::attorney::create_from(
+        [state = state_](auto&& promise) {
+          state->subscribe(std::forward<decltype(promise)>(promise));
+        },
+        detail::identity<Args...>{}, detail::util::ownership{});
+  }
+
+  /// \copydoc continuable_base::then
+  template <typename T, typename E = detail::types::this_thread_executor_tag>
+  auto then(T&& callback,
+            E&& executor = detail::types::this_thread_executor_tag{}) const {
+    detail::operations::accepts_shared_t<T, Args...> accepts;
+    return subscribe(accepts).then(
+        consumer_of(accepts, std::forward<T>(callback)),
+        std::forward<E>(executor));
+  }
+
+  /// \copydoc continuable_base::fail
+  template <typename T, typename E = detail::types::this_thread_executor_tag>
+  auto fail(T&& callback,
+            E&& executor = detail::types::this_thread_executor_tag{}) const {
+    return to_continuable().fail(std::forward<T>(callback),
+                                 std::forward<E>(executor));
+  }
+
+  /// \copydoc continuable_base::next
+  template <typename T, typename E = detail::types::this_thread_executor_tag>
+  auto next(T&& callback,
+            E&& executor = detail::types::this_thread_executor_tag{}) const {
+    detail::operations::accepts_shared_t<T, Args...> accepts;
+    return subscribe(accepts).next(
+        consumer_of(accepts, std::forward<T>(callback)),
+        std::forward<E>(executor));
+  }
+
+private:
+  /// Returns a continuable_base without arguments which is resolved when
+  /// the shared result is available, the consumer reads the values
+  /// from the shared state instead of receiving a copy of them.
+  auto subscribe(std::true_type) const {
+    assert(state_);
+    return detail::base::attorney::create_from(
+        [state = state_](auto&& promise) {
+          using promise_t = detail::traits::unrefcv_t<decltype(promise)>;
+          state->subscribe(detail::operations::shared_signal<promise_t>(
+              std::forward<decltype(promise)>(promise)));
+        },
+        detail::identity<>{}, detail::util::ownership{});
+  }
+  auto subscribe(std::false_type) const {
+    return to_continuable();
+  }
+
+  template <typename T>
+  auto consumer_of(std::true_type, T&& callback) const {
+    using consumer_t =
+        detail::operations::shared_consumer<detail::traits::unrefcv_t<T>,
+                                            Args...>;
+    return consumer_t(state_, std::forward<T>(callback));
+  }
+  template <typename T>
+  T&& consumer_of(std::false_type, T&& callback) const {
+    return std::forward<T>(callback);
+  }
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_SHARED_HPP_INCLUDED
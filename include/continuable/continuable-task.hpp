@@ -0,0 +1,154 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_TASK_HPP_INCLUDED
+#define CONTINUABLE_TASK_HPP_INCLUDED
+
+#include <utility>
+#include <continuable/continuable-coroutine.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/features.hpp>
+
+#if defined(CONTINUABLE_HAS_COROUTINE)
+#  include <continuable/detail/other/task.hpp>
+
+namespace cti {
+/// \ingroup Types
+/// \{
+
+/// A lazy coroutine type which is started when it is awaited,
+/// and resumes its awaiter directly when it finished.
+///
+/// In contrast to a coroutine returning a cti::continuable no type erased
+/// continuation or promise is allocated, such that calls between
+/// coroutines returning tasks don't require any allocation except for
+/// their pooled frames:
+/// ```cpp
+/// cti::task<int> fetch_size() {
+///   std::string page = co_await http_request("example.com");
+///   co_return page.size();
+/// }
+///
+/// cti::task<int> twice_the_size() {
+///   int size = co_await fetch_size();
+///   co_return size * 2;
+/// }
+/// ```
+///
+/// A task can be converted into a continuable through task::to_continuable,
+/// when its result is consumed outside of a coroutine.
+///
+/// \tparam Args The arguments the task is resolved with, a task with
+///              multiple arguments is resumed with a std::tuple of those.
+///
+/// \since 4.3.0
+template <typename... Args>
+class task {
+  using handle_t = detail::awaiting::coroutine_handle<>;
+  using state_t = detail::awaiting::task_state<Args...>;
+
+  handle_t handle_;
+  state_t* state_ = nullptr;
+
+public:
+  /// Constructs the task from the handle of its suspended coroutine
+  /// and the state inside of its promise.
+  explicit task(handle_t handle, state_t* state) noexcept
+    : handle_(handle), state_(state) {}
+  /// Destroys the coroutine of the task if it wasn't started
+  ~task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  task(task const&) = delete;
+  task(task&& other) noexcept
+    : handle_(std::exchange(other.handle_, {})), state_(other.state_) {}
+  task& operator=(task const&) = delete;
+  task& operator=(task&& other) noexcept {
+    task(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  /// Swaps this task with the given one
+  void swap(task& other) noexcept {
+    std::swap(handle_, other.handle_);
+    std::swap(state_, other.state_);
+  }
+
+  /// Returns true when the task wasn't started or moved away
+  bool is_valid() const noexcept {
+    return bool(handle_);
+  }
+
+  /// Converts the task into a continuable, which starts the task when
+  /// the continuable is invoked.
+  ///
+  /// \attention The conversion allocates the type erased continuation of
+  ///            the returned continuable, hence tasks should be
+  ///            awaited directly from coroutines where possible.
+  continuable<Args...> to_continuable() && {
+    return detail::awaiting::await_task<continuable<Args...>>(std::move(*this));
+  }
+
+  /// Starts the task and suspends the awaiting coroutine until
+  /// the task finished.
+  ///
+  /// \returns An awaitable which resumes the coroutine with the value of
+  ///          the task, or which rethrows the exception it finished with.
+  auto operator co_await() && noexcept {
+    return detail::awaiting::task_awaitable<Args...>(
+        std::exchange(handle_, {}), state_);
+  }
+};
+/// \}
+} // namespace cti
+
+/// \cond false
+// NOLINTNEXTLINE(cert-dcl58-cpp)
+namespace std {
+#  if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+namespace experimental {
+#  endif // defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+template <typename... Args, typename... FunctionArgs>
+struct coroutine_traits<cti::task<Args...>, FunctionArgs...> {
+  using promise_type = cti::detail::awaiting::task_promise<
+      cti::task<Args...>, cti::detail::awaiting::frame_base_of<FunctionArgs...>,
+      Args...>;
+};
+#  if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+} // namespace experimental
+#  endif // defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+} // namespace std
+/// \endcond
+#endif // defined(CONTINUABLE_HAS_COROUTINE)
+
+#endif // CONTINUABLE_TASK_HPP_INCLUDED
@@ -0,0 +1,136 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_THREAD_POOL_HPP_INCLUDED
+#define CONTINUABLE_THREAD_POOL_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/other/thread-pool.hpp>
+
+namespace cti {
+/// \defgroup Executors Executors
+/// provides the \link cti::thread_pool thread_pool\endlink which can be
+/// used as executor for continuable_base::then, continuable_base::via
+/// and cti::async_on.
+/// \{
+
+/// A work-stealing thread pool which executes the work passed to
+/// its executor.
+///
+/// Every thread of the pool owns a lock-free deque and steals work from
+/// the other threads when its own deque runs empty.
+/// Work which is scheduled from a thread of the pool, which is mostly the
+/// continuation of the currently executed work, is executed next on the
+/// same thread, such that chained continuations stay cache hot:
+/// ```cpp
+/// cti::thread_pool pool(4);
+///
+/// cti::async_on([] {
+///   return load_file("config.json");
+/// }, pool.executor())
+///   .then([](std::string content) {
+///     // Continued on the same thread of the pool
+///   }, pool.executor());
+/// ```
+///
+/// The destructor waits for all work to complete, including work which is
+/// scheduled by the executed work itself.
+///
+/// \since 4.3.0
+class thread_pool {
+  detail::pool::thread_pool pool_;
+
+public:
+  /// The lightweight and copyable executor type of the pool
+  using executor_type = detail::pool::thread_pool_executor;
+
+  /// Starts a thread pool with the given count of threads,
+  /// which defaults to the count of hardware threads.
+  explicit thread_pool(std::size_t threads = std::max(
+                           1U, std::thread::hardware_concurrency()))
+      : pool_(threads) {
+  }
+
+  /// Completes all outstanding work and joins the threads.
+  ///
+  /// \attention The pool must not be destroyed from one of its threads.
+  ~thread_pool() = default;
+
+  thread_pool(thread_pool const&) = delete;
+  thread_pool(thread_pool&&) = delete;
+  thread_pool& operator=(thread_pool const&) = delete;
+  thread_pool& operator=(thread_pool&&) = delete;
+
+  /// Returns an executor which schedules the work passed to it on this pool.
+  ///
+  /// The executor accepts a \ref work directly without erasing it again.
+  /// Queued work is stored in nodes which are recycled by the threads of
+  /// the pool, hence work scheduled from a thread of the pool, which is
+  /// executed by the same thread, doesn't allocate.
+  /// The executor must not outlive the pool.
+  executor_type executor() noexcept {
+    return executor_type(pool_);
+  }
+
+  /// Schedules the given work for execution on this pool.
+  ///
+  /// Work which is scheduled after the destruction of the pool was started
+  /// from a thread outside of the pool is resolved through
+  /// work::set_canceled instead.
+  void post(work task) {
+    pool_.schedule(std::move(task));
+  }
+
+  /// Returns the count of threads of this pool
+  std::size_t size() const noexcept {
+    return pool_.size();
+  }
+
+  /// Returns the approximated count of work which is queued in this pool
+  /// and which wasn't started yet, including the work which is about to be
+  /// executed next by a thread of the pool.
+  std::size_t queue_depth() const noexcept {
+    return pool_.queue_depth();
+  }
+
+  /// Returns the count of work that was stolen from the queue of another
+  /// thread of this pool so far.
+  std::size_t steals() const noexcept {
+    return pool_.steals();
+  }
+};
+/// \}
+} // namespace cti
+
+#endif // CONTINUABLE_THREAD_POOL_HPP_INCLUDED
@@ -51,6 +51,27 @@ namespace cti {
 template <typename... Args>
 using continuation_capacity = detail::erasure::continuation_capacity<Args...>;
 
+/// Deduces to the inplace capacity of the type erased \ref promise.
+/// The given capacity is large enough to store the callbacks created by
+/// a continuable_base::then, continuable_base::fail or continuable_base::next
+/// call whose handler captures a few pointers only, without any allocation.
+///
+/// \since 4.3.0
+using callback_capacity = detail::erasure::callback_capacity;
+
+/// Deduces to a std::true_type if the given callable object T is stored
+/// inside the inplace capacity of a \ref promise, and to a std::false_type
+/// if it is allocated on the heap instead.
+///
+/// ```cpp
+/// auto callback = [ptr = &value](int) { /* ... */ };
+/// static_assert(cti::is_inplace_callback<decltype(callback)>::value, "");
+/// ```
+///
+/// \since 4.3.0
+template <typename T>
+using is_inplace_callback = detail::erasure::is_inplace_callback<T>;
+
 /// Defines a non-copyable continuation type which uses the
 /// function2 backend for type erasure.
 ///
@@ -96,6 +117,52 @@ using promise = promise_base<detail::erasure::callback<Args...>, //
 /// \since 4.0.0
 using work = promise_base<detail::erasure::work, //
                           signature_arg_t<>>;
+
+/// Defines a non-copyable continuation type like \ref continuable,
+/// which allocates its type erased objects through the given Allocator.
+///
+/// The Allocator is propagated to the \ref basic_promise objects
+/// which are created when the continuation is invoked.
+/// Therefore all heap memory required to type erase the asynchronous
+/// call chain is served by the same allocator, which makes it possible
+/// to use per-request arenas or per-thread pools for instance:
+///
+/// ```cpp
+/// cti::basic_continuable<arena_allocator<void>, int> c =
+///   cti::make_continuable<int>([](auto&& promise) {
+///     // ...
+///   });
+/// ```
+///
+/// \note The Allocator is default constructed when an object is converted
+///       into the type erasure, stateful allocators hence need to
+///       retrieve their state in their default constructor
+///       (from a thread-local arena for instance).
+///       The allocator is rebound to the type erased object through
+///       `std::allocator_traits`.
+///
+/// \since 4.3.0
+template <typename Allocator, typename... Args>
+using basic_continuable =
+    continuable_base<detail::erasure::basic_continuation<Allocator, Args...>,
+                     signature_arg_t<Args...>>;
+
+/// Defines a non-copyable promise type like \ref promise,
+/// which allocates its type erased callback through the given Allocator.
+///
+/// \since 4.3.0
+template <typename Allocator, typename... Args>
+using basic_promise =
+    promise_base<detail::erasure::basic_callback<Allocator, Args...>,
+                 signature_arg_t<Args...>>;
+
+/// Defines a non-copyable work type like \ref work,
+/// which allocates its type erased callable through the given Allocator.
+///
+/// \since 4.3.0
+template <typename Allocator>
+using basic_work = promise_base<detail::erasure::basic_work<Allocator>, //
+                                signature_arg_t<>>;
 /// \}
 } // namespace cti
 
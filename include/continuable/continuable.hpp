@@ -42,17 +42,27 @@
 /// Also there are following support functions available:
 /// - cti::when_all() - connects cti::continuable_base's to an `all` connection.
 /// - cti::when_any() - connects cti::continuable_base's to an `any` connection.
+/// - cti::when_any_cancel() - like cti::when_any(), but cancels the remaining
+///   cti::continuable_base's once the first one was resolved.
 /// - cti::when_seq() - connects cti::continuable_base's to a sequence.
 namespace cti {}
 
 #include <continuable/continuable-base.hpp>
+#include <continuable/continuable-cancellation.hpp>
+#include <continuable/continuable-channel.hpp>
 #include <continuable/continuable-connections.hpp>
 #include <continuable/continuable-coroutine.hpp>
+#include <continuable/continuable-future.hpp>
+#include <continuable/continuable-generator.hpp>
+#include <continuable/continuable-mutex.hpp>
 #include <continuable/continuable-operations.hpp>
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/continuable-promise-base.hpp>
 #include <continuable/continuable-promisify.hpp>
 #include <continuable/continuable-result.hpp>
+#include <continuable/continuable-shared.hpp>
+#include <continuable/continuable-task.hpp>
+#include <continuable/continuable-thread-pool.hpp>
 #include <continuable/continuable-transforms.hpp>
 #include <continuable/continuable-traverse-async.hpp>
 #include <continuable/continuable-traverse.hpp>
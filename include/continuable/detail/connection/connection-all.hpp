@@ -33,7 +33,6 @@
 
 #include <atomic>
 #include <memory>
-#include <mutex>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -42,7 +41,9 @@
 #include <continuable/detail/connection/connection.hpp>
 #include <continuable/detail/core/annotation.hpp>
 #include <continuable/detail/core/base.hpp>
+#include <continuable/detail/core/cancellation.hpp>
 #include <continuable/detail/core/types.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
 #include <continuable/detail/utility/traits.hpp>
 
 namespace cti {
@@ -53,40 +54,58 @@ namespace all {
 /// are arrived. This class is thread safe.
 template <typename Callback, typename Result>
 class result_submitter
-    : public std::enable_shared_from_this<result_submitter<Callback, Result>>,
-      public util::non_movable {
+    : public util::ref_counted<result_submitter<Callback, Result>> {
+
+  /// The most significant bit of the state is set when the connection was
+  /// finished by the first error, the remaining bits count the
+  /// results which didn't arrive yet.
+  static constexpr std::size_t finished_bit = ~(~std::size_t(0U) >> 1U);
 
   Callback callback_;
   Result result_;
 
-  std::atomic<std::size_t> left_;
-  std::once_flag flag_;
+  std::atomic<std::size_t> state_;
+  // The cancellation state of the following chain, which is captured
+  // on construction since the callback is moved away on completion.
+  util::ref_ptr<cancellation::cancellation_state> cancellation_;
 
   // Invokes the callback with the cached result
   void invoke() {
-    assert((left_ == 0U) && "Expected that the submitter is finished!");
-    std::atomic_thread_fence(std::memory_order_acquire);
+    assert((state_.load(std::memory_order_relaxed) == 0U) &&
+           "Expected that the submitter is finished!");
 
     // Call the final callback with the cleaned result
-    std::call_once(flag_, [&] {
-      aggregated::finalize_data(std::move(callback_), std::move(result_));
-    });
+    aggregated::finalize_data(std::move(callback_), std::move(result_));
   }
 
   // Completes one result
   void complete_one() {
-    assert((left_ > 0U) && "Expected that the submitter isn't finished!");
+    assert(((state_.load(std::memory_order_relaxed) & ~finished_bit) > 0U) &&
+           "Expected that the submitter isn't finished!");
 
-    auto const current = --left_;
-    if (!current) {
+    // The connection is finished by the last arriving result, as long
+    // as it wasn't finished by an error before.
+    auto const previous = state_.fetch_sub(1U, std::memory_order_acq_rel);
+    if (previous == 1U) {
       invoke();
     }
   }
 
+  // Fails the connection with the given exception
+  void fail(exception_t exception) {
+    // We never complete the connection, but we forward the first error
+    // which was raised.
+    auto const previous =
+        state_.fetch_or(finished_bit, std::memory_order_acq_rel);
+    if (!(previous & finished_bit)) {
+      std::move(callback_)(exception_arg_t{}, std::move(exception));
+    }
+  }
+
   template <typename Box>
   struct partial_all_callback {
     Box* box;
-    std::shared_ptr<result_submitter> me;
+    util::ref_ptr<result_submitter> me;
 
     template <typename... Args>
     void operator()(Args&&... args) && {
@@ -99,25 +118,49 @@ class result_submitter
     }
 
     template <typename... PartialArgs>
-    void operator()(exception_arg_t tag, exception_t exception) && {
-      // We never complete the connection, but we forward the first error
-      // which was raised.
-      std::call_once(me->flag_, std::move(me->callback_), tag,
-                     std::move(exception));
+    void operator()(exception_arg_t, exception_t exception) && {
+      me->fail(std::move(exception));
+    }
+
+    template <typename... Args>
+    void set_value(Args&&... args) {
+      std::move(*this)(std::forward<Args>(args)...);
+    }
+
+    void set_exception(exception_t exception) {
+      std::move(*this)(exception_arg_t{}, std::move(exception));
+    }
+
+    void set_canceled() {
+      std::move(*this)(exception_arg_t{}, exception_t{});
+    }
+
+    bool is_cancelled() const noexcept {
+      return cancellation::is_cancelled(*this);
+    }
+
+    /// Exposes the cancellation state of the chain following the connection
+    cancellation::cancellation_state* get_cancellation_state() const noexcept {
+      return me->cancellation_.get();
+    }
+
+    explicit operator bool() const noexcept {
+      return true;
     }
   };
 
 public:
   explicit result_submitter(Callback callback, Result&& result)
-      : callback_(std::move(callback)), result_(std::move(result)), left_(1) {
+      : callback_(std::move(callback)), result_(std::move(result)), state_(1),
+        cancellation_(
+            cancellation::share_state(cancellation::state_of(callback_))) {
   }
 
   /// Creates a submitter which submits it's result into the storage
   template <typename Box>
   auto create_callback(Box* box) {
-    left_.fetch_add(1, std::memory_order_seq_cst);
-    return partial_all_callback<std::decay_t<Box>>{box,
-                                                   this->shared_from_this()};
+    state_.fetch_add(1U, std::memory_order_relaxed);
+    return partial_all_callback<std::decay_t<Box>>{box, util::ref_of(this)};
   }
 
   /// Initially the counter is created with an initial count of 1 in order
@@ -134,13 +177,16 @@ public:
 
 template <typename Submitter>
 struct continuable_dispatcher {
-  std::shared_ptr<Submitter>& submitter;
+  util::ref_ptr<Submitter>& submitter;
 
   template <typename Box, std::enable_if_t<aggregated::is_continuable_box<
                               std::decay_t<Box>>::value>* = nullptr>
   void operator()(Box&& box) const {
-    // Retrieve a callback from the submitter and attach it to the continuable
-    box.fetch().next(submitter->create_callback(std::addressof(box))).done();
+    // Retrieve a callback from the submitter and invoke the continuable
+    // with it directly, such that it observes the cancellation state of
+    // the chain following the connection.
+    base::invoke_continuation(box.fetch(),
+                              submitter->create_callback(std::addressof(box)));
   }
 };
 } // namespace all
@@ -170,7 +216,7 @@ struct connection_finalizer<connection_strategy_all_tag> {
 
           // Create the shared state which holds the result
           // and the final callback
-          auto state = std::make_shared<submitter_t>(
+          auto state = util::make_ref<submitter_t>(
               std::forward<decltype(callback)>(callback), std::move(res));
 
           // Dispatch the continuables and store its partial result
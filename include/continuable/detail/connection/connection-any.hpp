@@ -32,8 +32,6 @@
 #define CONTINUABLE_DETAIL_CONNECTION_ANY_HPP_INCLUDED
 
 #include <atomic>
-#include <memory>
-#include <mutex>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -42,47 +40,107 @@
 #include <continuable/continuable-traverse.hpp>
 #include <continuable/detail/core/annotation.hpp>
 #include <continuable/detail/core/base.hpp>
+#include <continuable/detail/core/cancellation.hpp>
 #include <continuable/detail/core/types.hpp>
 #include <continuable/detail/traversal/container-category.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
 #include <continuable/detail/utility/traits.hpp>
 
 namespace cti {
 namespace detail {
 namespace connection {
 namespace any {
-/// Invokes the callback with the first arriving result
-template <typename T>
+/// Invokes the callback with the first arriving result.
+///
+/// When CancelRemaining is true the submitter owns a cancellation state
+/// which is cancelled as soon as the first result arrived, otherwise the
+/// remaining continuables only observe the cancellation state of the chain
+/// following the connection and run to completion.
+template <typename T, bool CancelRemaining>
 class any_result_submitter
-    : public std::enable_shared_from_this<any_result_submitter<T>>,
-      public util::non_movable {
+    : public util::ref_counted<any_result_submitter<T, CancelRemaining>> {
 
   T callback_;
-  std::once_flag flag_;
+  std::atomic<bool> finished_{false};
+  // The cancellation state observed by the connected continuables.
+  // It is the state of the chain following the connection, or a state
+  // linked to it when the remaining continuables are cancelled.
+  util::ref_ptr<cancellation::cancellation_state> cancellation_;
 
   struct any_callback {
-    std::shared_ptr<any_result_submitter> me_;
+    util::ref_ptr<any_result_submitter> me_;
 
     template <typename... PartialArgs>
     void operator()(PartialArgs&&... args) && {
       me_->invoke(std::forward<decltype(args)>(args)...);
     }
+
+    template <typename... Args>
+    void set_value(Args&&... args) {
+      std::move(*this)(std::forward<Args>(args)...);
+    }
+
+    void set_exception(exception_t exception) {
+      std::move(*this)(exception_arg_t{}, std::move(exception));
+    }
+
+    void set_canceled() {
+      std::move(*this)(exception_arg_t{}, exception_t{});
+    }
+
+    bool is_cancelled() const noexcept {
+      return cancellation::is_cancelled(*this);
+    }
+
+    /// Exposes the cancellation state of the connection
+    cancellation::cancellation_state* get_cancellation_state() const noexcept {
+      return me_->cancellation_.get();
+    }
+
+    explicit operator bool() const noexcept {
+      return true;
+    }
   };
 
+  static util::ref_ptr<cancellation::cancellation_state>
+  make_cancellation(std::false_type, cancellation::cancellation_state* chain) {
+    return cancellation::share_state(chain);
+  }
+  static util::ref_ptr<cancellation::cancellation_state>
+  make_cancellation(std::true_type, cancellation::cancellation_state* chain) {
+    return util::make_ref<cancellation::cancellation_state>(
+        cancellation::share_state(chain));
+  }
+
 public:
-  explicit any_result_submitter(T callback) : callback_(std::move(callback)) {
+  explicit any_result_submitter(T callback)
+      : callback_(std::move(callback)),
+        cancellation_(
+            make_cancellation(std::integral_constant<bool, CancelRemaining>{},
+                              cancellation::state_of(callback_))) {
   }
 
   /// Creates a submitter which submits it's result to the callback
   auto create_callback() {
-    return any_callback{this->shared_from_this()};
+    return any_callback{util::ref_of(this)};
   }
 
 private:
   // Invokes the callback with the given arguments
   template <typename... ActualArgs>
   void invoke(ActualArgs&&... args) {
-    std::call_once(flag_, std::move(callback_),
-                   std::forward<ActualArgs>(args)...);
+    // Results which arrive after the connection was finished are dropped
+    // without writing to the shared state.
+    if (!finished_.load(std::memory_order_relaxed) &&
+        !finished_.exchange(true, std::memory_order_acquire)) {
+      if (CancelRemaining) {
+        // Abandon the remaining continuables, continuations which weren't
+        // started yet aren't invoked at all.
+        cancellation_->cancel();
+      }
+
+      std::move(callback_)(std::forward<ActualArgs>(args)...);
+    }
   }
 };
 
@@ -145,49 +203,78 @@ struct result_deducer {
 
 template <typename Submitter>
 struct continuable_dispatcher {
-  std::shared_ptr<Submitter>& submitter;
+  util::ref_ptr<Submitter>& submitter;
 
   template <typename Continuable,
             std::enable_if_t<base::is_continuable<
                 std::decay_t<Continuable>>::value>* = nullptr>
   void operator()(Continuable&& continuable) {
-    // Retrieve a callback from the submitter and attach it to the continuable
-    std::forward<Continuable>(continuable)
-        .next(submitter->create_callback())
-        .done();
+    // Retrieve a callback from the submitter and invoke the continuable
+    // with it directly, such that it observes the cancellation state of
+    // the chain following the connection.
+    base::invoke_continuation(std::forward<Continuable>(continuable),
+                              submitter->create_callback());
   }
 };
 } // namespace any
 
+namespace any {
+/// Connects the continuables of the given connection such that the callback
+/// is invoked with the first arriving result
+template <bool CancelRemaining, typename Connection>
+auto finalize(Connection&& connection, util::ownership ownership) {
+  constexpr auto const signature = decltype(any::result_deducer::deduce(
+      traversal::container_category_of_t<std::decay_t<Connection>>{},
+      identity<std::decay_t<Connection>>{})){};
+
+  return base::attorney::create_from(
+      [connection =
+           std::forward<Connection>(connection)](auto&& callback) mutable {
+        using submitter_t =
+            any::any_result_submitter<std::decay_t<decltype(callback)>,
+                                      CancelRemaining>;
+
+        // Create the submitter which calls the given callback once at the
+        // first callback invocation.
+        auto submitter = util::make_ref<submitter_t>(
+            std::forward<decltype(callback)>(callback));
+
+        traverse_pack(any::continuable_dispatcher<submitter_t>{submitter},
+                      std::move(connection));
+      },
+      signature, std::move(ownership));
+}
+} // namespace any
+
 struct connection_strategy_any_tag {};
 template <>
 struct is_connection_strategy<connection_strategy_any_tag> // ...
     : std::true_type {};
 
+/// The any strategy which cancels the remaining continuables
+/// once the first result arrived.
+struct connection_strategy_any_cancel_tag {};
+template <>
+struct is_connection_strategy<connection_strategy_any_cancel_tag> // ...
+    : std::true_type {};
+
 /// Finalizes the any logic of a given connection
 template <>
 struct connection_finalizer<connection_strategy_any_tag> {
   template <typename Connection>
   static auto finalize(Connection&& connection, util::ownership ownership) {
-    constexpr auto const signature = decltype(any::result_deducer::deduce(
-        traversal::container_category_of_t<std::decay_t<Connection>>{},
-        identity<std::decay_t<Connection>>{})){};
-
-    return base::attorney::create_from(
-        [connection =
-             std::forward<Connection>(connection)](auto&& callback) mutable {
-          using submitter_t =
-              any::any_result_submitter<std::decay_t<decltype(callback)>>;
-
-          // Create the submitter which calls the given callback once at the
-          // first callback invocation.
-          auto submitter = std::make_shared<submitter_t>(
-              std::forward<decltype(callback)>(callback));
-
-          traverse_pack(any::continuable_dispatcher<submitter_t>{submitter},
-                        std::move(connection));
-        },
-        signature, std::move(ownership));
+    return any::finalize<false>(std::forward<Connection>(connection),
+                                std::move(ownership));
+  }
+};
+
+/// Finalizes the cancelling any logic of a given connection
+template <>
+struct connection_finalizer<connection_strategy_any_cancel_tag> {
+  template <typename Connection>
+  static auto finalize(Connection&& connection, util::ownership ownership) {
+    return any::finalize<true>(std::forward<Connection>(connection),
+                               std::move(ownership));
   }
 };
 } // namespace connection
@@ -197,6 +284,10 @@ template <>
 struct annotation_trait<connection::connection_strategy_any_tag>
     : connection::connection_annotation_trait<
           connection::connection_strategy_any_tag> {};
+template <>
+struct annotation_trait<connection::connection_strategy_any_cancel_tag>
+    : connection::connection_annotation_trait<
+          connection::connection_strategy_any_cancel_tag> {};
 
 } // namespace detail
 } // namespace cti
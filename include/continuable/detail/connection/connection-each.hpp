@@ -0,0 +1,203 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_CONNECTION_EACH_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_CONNECTION_EACH_HPP_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-primitives.hpp>
+#include <continuable/detail/core/base.hpp>
+#include <continuable/detail/core/cancellation.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+#include <exception>
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+namespace cti {
+namespace detail {
+namespace connection {
+namespace each {
+/// Passes the result of every connected continuable to the handler as soon
+/// as it arrived and resolves the callback after all of them completed.
+///
+/// In contrast to the all connection no result is stored inside the
+/// submitter, hence its size doesn't depend on the count of continuables.
+template <typename Callback, typename Handler>
+class each_submitter
+    : public util::ref_counted<each_submitter<Callback, Handler>> {
+
+  Callback callback_;
+  Handler handler_;
+  // The count of running continuables, plus one until all were started
+  std::atomic<std::size_t> outstanding_{1U};
+  std::atomic<bool> failed_{false};
+  exception_t exception_;
+  // The cancellation state observed by the connected continuables,
+  // which is cancelled on the first failure and is linked to the
+  // cancellation state of the chain following the connection.
+  util::ref_ptr<cancellation::cancellation_state> cancellation_;
+
+  struct each_callback {
+    util::ref_ptr<each_submitter> me_;
+
+    template <typename... Args>
+    void operator()(Args&&... args) && {
+      me_->resolve(std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void set_value(Args&&... args) {
+      std::move(*this)(std::forward<Args>(args)...);
+    }
+
+    void set_exception(exception_t exception) {
+      std::move(*this)(exception_arg_t{}, std::move(exception));
+    }
+
+    void set_canceled() {
+      std::move(*this)(exception_arg_t{}, exception_t{});
+    }
+
+    bool is_cancelled() const noexcept {
+      return cancellation::is_cancelled(*this);
+    }
+
+    /// Exposes the cancellation state of the connection
+    cancellation::cancellation_state* get_cancellation_state() const noexcept {
+      return me_->cancellation_.get();
+    }
+
+    explicit operator bool() const noexcept {
+      return true;
+    }
+  };
+
+public:
+  explicit each_submitter(Callback callback, Handler handler)
+      : callback_(std::move(callback)), handler_(std::move(handler)),
+        cancellation_(util::make_ref<cancellation::cancellation_state>(
+            cancellation::share_state(cancellation::state_of(callback_)))) {
+  }
+
+  /// Starts the given continuable and passes its result to the handler
+  template <typename Continuable>
+  void dispatch(Continuable&& continuable) {
+    outstanding_.fetch_add(1U, std::memory_order_relaxed);
+
+    base::invoke_continuation(std::forward<Continuable>(continuable),
+                              each_callback{util::ref_of(this)});
+  }
+
+  /// Is called after all continuables were started
+  void accept() {
+    release();
+  }
+
+private:
+  template <typename... Args>
+  void resolve(Args&&... args) {
+    // Results which arrive after a failure aren't handled anymore
+    if (!failed_.load(std::memory_order_acquire)) {
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+      try {
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+        util::invoke(handler_, std::forward<Args>(args)...);
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+      } catch (...) {
+        fail(std::current_exception());
+      }
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+    }
+
+    release();
+  }
+
+  void resolve(exception_arg_t, exception_t exception) {
+    fail(std::move(exception));
+    release();
+  }
+
+  void fail(exception_t exception) {
+    if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+      exception_ = std::move(exception);
+
+      // The remaining results are dropped, so abandon their continuables
+      cancellation_->cancel();
+    }
+  }
+
+  void release() {
+    if (outstanding_.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+      if (failed_.load(std::memory_order_relaxed)) {
+        std::move(callback_).set_exception(std::move(exception_));
+      } else {
+        std::move(callback_).set_value();
+      }
+    }
+  }
+};
+
+/// Starts all continuables of the given container and passes their results
+/// to the handler in the order of their arrival.
+template <typename Container, typename Handler>
+auto when_each(Container&& container, Handler&& handler) {
+  return make_continuable<void>(
+      [container = std::forward<Container>(container),
+       handler = std::forward<Handler>(handler)](auto&& promise) mutable {
+        using submitter_t =
+            each_submitter<std::decay_t<decltype(promise)>,
+                           std::decay_t<Handler>>;
+
+        auto submitter = util::make_ref<submitter_t>(
+            std::forward<decltype(promise)>(promise), std::move(handler));
+
+        for (auto&& continuable : container) {
+          submitter->dispatch(std::move(continuable));
+        }
+
+        submitter->accept();
+      });
+}
+} // namespace each
+} // namespace connection
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_CONNECTION_EACH_HPP_INCLUDED
@@ -40,6 +40,7 @@
 #include <continuable/continuable-traverse-async.hpp>
 #include <continuable/detail/connection/connection-aggregated.hpp>
 #include <continuable/detail/core/base.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
 #include <continuable/detail/utility/traits.hpp>
 #include <continuable/detail/utility/util.hpp>
 
@@ -76,8 +77,7 @@ struct sequential_dispatch_data {
 
 template <typename Data>
 class sequential_dispatch_visitor
-    : public std::enable_shared_from_this<sequential_dispatch_visitor<Data>>,
-      public util::non_movable {
+    : public util::ref_counted<sequential_dispatch_visitor<Data>> {
 
   Data data_;
 
@@ -119,7 +119,7 @@ public:
           // Continue the asynchronous sequential traversal
           next();
         })
-        .fail([me = this->shared_from_this()](exception_t exception) {
+        .fail([me = util::ref_of(this)](exception_t exception) {
           // Abort the traversal when an error occurred
           std::move(me->data_.callback)(exception_arg_t{},
                                         std::move(exception));
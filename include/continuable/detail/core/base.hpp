@@ -37,6 +37,8 @@
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/continuable-result.hpp>
 #include <continuable/detail/core/annotation.hpp>
+#include <continuable/detail/core/cancellation.hpp>
+#include <continuable/detail/core/resumption.hpp>
 #include <continuable/detail/core/types.hpp>
 #include <continuable/detail/features.hpp>
 #include <continuable/detail/utility/result-trait.hpp>
@@ -544,6 +546,12 @@ public:
   work_proxy& operator=(work_proxy const&) = delete;
 
   void set_value() noexcept {
+    // Skip the work when the chain was cancelled while it was queued
+    if (cancellation::is_cancelled(next_callback_)) {
+      std::move(next_callback_)(exception_arg_t{}, exception_t{});
+      return;
+    }
+
     traits::unpack(
         [&](auto&&... captured_args) {
           // Just use the packed dispatch method which dispatches the work_proxy
@@ -571,6 +579,11 @@ public:
     std::move(next_callback_)(exception_arg_t{}, exception_t{});
   }
 
+  /// Makes it possible for executors to drop cancelled work early
+  cancellation::cancellation_state* get_cancellation_state() const noexcept {
+    return cancellation::state_of(next_callback_);
+  }
+
   explicit operator bool() const noexcept {
     return true;
   }
@@ -630,6 +643,17 @@ template <typename Base, typename... Args>
 struct result_handler_base<handle_results::yes, Base, identity<Args...>> {
   /// The operator which is called when the result was provided
   void operator()(Args... args) && {
+    // Skip the callback when the result isn't consumed anymore
+    if (cancellation::is_cancelled(static_cast<Base*>(this)->next_callback_)) {
+      std::move(static_cast<Base*>(this)->next_callback_)(exception_arg_t{},
+                                                          exception_t{});
+      return;
+    }
+
+    // Coroutines which are resolved by the callback are resumed before
+    // the resolution returns, hence a finishing coroutine can't defer them
+    awaiting::close_resumption_slot();
+
     // In order to retrieve the correct decorator we must know what the
     // result type is.
     constexpr auto result = identify<decltype(decoration::invoke_callback(
@@ -662,6 +686,15 @@ template <typename Base>
 struct error_handler_base<handle_errors::forward, Base> {
   /// The operator which is called when an error occurred
   void operator()(exception_arg_t, exception_t exception) && {
+    // Skip the callback when the result isn't consumed anymore
+    if (cancellation::is_cancelled(static_cast<Base*>(this)->next_callback_)) {
+      std::move(static_cast<Base*>(this)->next_callback_)(exception_arg_t{},
+                                                          exception_t{});
+      return;
+    }
+
+    awaiting::close_resumption_slot();
+
     constexpr auto result = identify<decltype(decoration::invoke_callback(
         std::move(static_cast<Base*>(this)->callback_), exception_arg_t{},
         std::move(exception)))>{};
@@ -736,6 +769,16 @@ struct callback_base<identity<Args...>, HandleResults, HandleErrors, Callback,
     std::move (*this)(exception_arg_t{}, exception_t{});
   }
 
+  /// Returns true when the cancellation of the chain was requested
+  bool is_cancelled() const noexcept {
+    return cancellation::is_cancelled(next_callback_);
+  }
+
+  /// Exposes the cancellation state of the following chain
+  cancellation::cancellation_state* get_cancellation_state() const noexcept {
+    return cancellation::state_of(next_callback_);
+  }
+
   /// Returns true because this is a present continuation
   explicit operator bool() const noexcept {
     return true;
@@ -804,6 +847,59 @@ struct final_callback : util::non_copyable {
     std::move (*this)(exception_arg_t{}, exception_t{});
   }
 
+  bool is_cancelled() const noexcept {
+    return false;
+  }
+
+  explicit operator bool() const noexcept {
+    return true;
+  }
+};
+
+/// Exposes the cancellation state of the given token to the callbacks
+/// chained in front of it, and forwards everything else to the next callback.
+template <typename NextCallback>
+struct cancellable_callback : util::non_copyable {
+  cancellation::cancellation_token token_;
+  NextCallback next_callback_;
+
+  explicit cancellable_callback(cancellation::cancellation_token token,
+                                NextCallback next_callback)
+      : token_(std::move(token)), next_callback_(std::move(next_callback)) {
+  }
+
+  /// Results which arrive after the cancellation are dropped
+  template <typename... Args>
+  void operator()(Args&&... args) && {
+    if (token_.is_cancelled()) {
+      std::move(next_callback_)(exception_arg_t{}, exception_t{});
+    } else {
+      std::move(next_callback_)(std::forward<Args>(args)...);
+    }
+  }
+
+  template <typename... Args>
+  void set_value(Args... args) noexcept {
+    std::move(*this)(std::move(args)...);
+  }
+
+  void set_exception(exception_t exception) noexcept {
+    std::move(*this)(exception_arg_t{}, std::move(exception));
+  }
+
+  void set_canceled() noexcept {
+    std::move(next_callback_)(exception_arg_t{}, exception_t{});
+  }
+
+  bool is_cancelled() const noexcept {
+    return token_.is_cancelled();
+  }
+
+  /// The closest token of the chain wins
+  cancellation::cancellation_state* get_cancellation_state() const noexcept {
+    return token_.get_cancellation_state();
+  }
+
   explicit operator bool() const noexcept {
     return true;
   }
@@ -890,6 +986,15 @@ struct chained_continuation<identity<Args...>, identity<NextArgs...>,
     // - Continuation: continuation<[](auto&& callback) { callback("hi"); }>
     // - Callback: [](std::string) { }
     // - NextCallback: []() { }
+    //
+    // The continuation isn't invoked at all when the following chain
+    // was cancelled already, since nobody would consume its result.
+    if (cancellation::is_cancelled(next_callback)) {
+      util::invoke(std::forward<NextCallback>(next_callback), exception_arg_t{},
+                   exception_t{});
+      return;
+    }
+
     auto proxy = callbacks::make_callback<identity<Args...>, HandleResults,
                                           HandleErrors>(
         std::move(callback_), std::move(executor_),
@@ -953,6 +1058,13 @@ struct chained_continuation<identity<Args...>, identity<NextArgs...>,
 
   template <typename NextCallback>
   void operator()(NextCallback&& next_callback) {
+    // Don't resolve the continuation when its result isn't consumed anymore
+    if (cancellation::is_cancelled(next_callback)) {
+      util::invoke(std::forward<NextCallback>(next_callback), exception_arg_t{},
+                   exception_t{});
+      return;
+    }
+
     auto proxy = callbacks::make_callback<identity<Args...>, HandleResults,
                                           HandleErrors>(
         std::move(callback_), std::move(executor_),
@@ -1016,6 +1128,42 @@ auto chain_continuation(Continuation&& continuation, Callback&& callback,
       next_hint, ownership);
 }
 
+/// Invokes the continuation with a callback which exposes the given
+/// cancellation token to the callbacks that are chained in front of it.
+template <typename Continuation>
+struct cancellable_continuation {
+  Continuation continuation_;
+  cancellation::cancellation_token token_;
+
+  template <typename NextCallback>
+  void operator()(NextCallback&& next_callback) {
+    if (token_.is_cancelled()) {
+      util::invoke(std::forward<NextCallback>(next_callback), exception_arg_t{},
+                   exception_t{});
+      return;
+    }
+
+    using callback_t =
+        callbacks::cancellable_callback<traits::unrefcv_t<NextCallback>>;
+    util::invoke(std::move(continuation_),
+                 callback_t(std::move(token_),
+                            std::forward<NextCallback>(next_callback)));
+  }
+};
+
+/// Attaches the given cancellation token to the continuation chain
+template <typename Data, typename... Args>
+auto attach_cancellation(
+    continuable_base<Data, identity<Args...>>&& continuation,
+    cancellation::cancellation_token token) {
+  auto ownership = attorney::ownership_of(continuation);
+  auto data = attorney::consume(std::move(continuation));
+
+  using continuation_t = cancellable_continuation<decltype(data)>;
+  return attorney::create_from(continuation_t{std::move(data), std::move(token)},
+                               identity<Args...>{}, ownership);
+}
+
 /// Final invokes the given continuation chain:
 ///
 /// For example given:
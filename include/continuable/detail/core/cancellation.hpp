@@ -0,0 +1,164 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_CANCELLATION_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_CANCELLATION_HPP_INCLUDED
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+#include <continuable/detail/utility/ref-counted.hpp>
+#include <continuable/detail/utility/traits.hpp>
+
+namespace cti {
+namespace detail {
+/// The namespace `cancellation` provides the shared state behind
+/// cancellation tokens and the protocol which makes the state of a token
+/// visible to all callbacks which are chained in front of it.
+///
+/// A callback exposes the cancellation state of the chain it continues
+/// through a `get_cancellation_state()` method, which returns a
+/// cancellation_state pointer or a nullptr when the chain isn't
+/// cancellable at all.
+namespace cancellation {
+/// The state which is shared between a cancellation_source and
+/// all of its cancellation_token objects.
+///
+/// A state can be linked to the state of an enclosing chain, in which case
+/// it is cancelled as well when the enclosing chain was cancelled.
+class cancellation_state : public util::ref_counted<cancellation_state> {
+  std::atomic<bool> cancelled_{false};
+  util::ref_ptr<cancellation_state> parent_;
+
+public:
+  cancellation_state() = default;
+  explicit cancellation_state(util::ref_ptr<cancellation_state> parent) noexcept
+      : parent_(std::move(parent)) {
+  }
+
+  bool is_cancelled() const noexcept {
+    return cancelled_.load(std::memory_order_acquire) ||
+           (parent_ && parent_->is_cancelled());
+  }
+
+  /// Returns true if the state was cancelled by this call
+  bool cancel() noexcept {
+    return !cancelled_.exchange(true, std::memory_order_acq_rel);
+  }
+};
+
+template <typename T, typename = traits::void_t<>>
+struct has_cancellation_state : std::false_type {};
+template <typename T>
+struct has_cancellation_state<
+    T, traits::void_t<decltype(std::declval<T const&>()
+                                   .get_cancellation_state())>>
+    : std::true_type {};
+
+/// Returns the cancellation state which is exposed by the given callback
+template <typename Callback,
+          std::enable_if_t<has_cancellation_state<Callback>::value>* = nullptr>
+cancellation_state* state_of(Callback const& callback) noexcept {
+  return callback.get_cancellation_state();
+}
+/// Callbacks which don't expose a state belong to non cancellable chains
+template <typename Callback,
+          std::enable_if_t<!has_cancellation_state<Callback>::value>* = nullptr>
+constexpr cancellation_state* state_of(Callback const& /*callback*/) noexcept {
+  return nullptr;
+}
+
+/// Returns true when the chain continued by the given callback was cancelled
+template <typename Callback>
+bool is_cancelled(Callback const& callback) noexcept {
+  cancellation_state const* const state = state_of(callback);
+  return state && state->is_cancelled();
+}
+
+/// Acquires an owning reference to the given state which might be a nullptr
+inline util::ref_ptr<cancellation_state>
+share_state(cancellation_state* state) noexcept {
+  return state ? util::ref_of(state) : util::ref_ptr<cancellation_state>{};
+}
+
+/// Observes the cancellation of a chain, see cti::cancellation_token
+class cancellation_token {
+  util::ref_ptr<cancellation_state> state_;
+
+public:
+  /// Creates a token which is never cancelled
+  cancellation_token() = default;
+  explicit cancellation_token(util::ref_ptr<cancellation_state> state) noexcept
+      : state_(std::move(state)) {
+  }
+
+  /// Returns true when the cancellation was requested
+  bool is_cancelled() const noexcept {
+    return state_ && state_->is_cancelled();
+  }
+
+  /// Returns true when the token can be cancelled at all
+  bool can_be_cancelled() const noexcept {
+    return bool(state_);
+  }
+
+  cancellation_state* get_cancellation_state() const noexcept {
+    return state_.get();
+  }
+};
+
+/// Requests the cancellation of chains, see cti::cancellation_source
+class cancellation_source {
+  util::ref_ptr<cancellation_state> state_;
+
+public:
+  cancellation_source() : state_(util::make_ref<cancellation_state>()) {
+  }
+
+  /// Returns a token which observes the cancellation of this source
+  cancellation_token token() const noexcept {
+    return cancellation_token(state_);
+  }
+
+  /// Requests the cancellation, returns true if it wasn't requested before
+  bool cancel() noexcept {
+    return state_->cancel();
+  }
+
+  /// Returns true when the cancellation was requested
+  bool is_cancelled() const noexcept {
+    return state_->is_cancelled();
+  }
+};
+} // namespace cancellation
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_CANCELLATION_HPP_INCLUDED
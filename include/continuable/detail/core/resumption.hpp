@@ -0,0 +1,94 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_RESUMPTION_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_RESUMPTION_HPP_INCLUDED
+
+#include <utility>
+#include <continuable/detail/features.hpp>
+
+#if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+#  include <experimental/coroutine>
+#elif defined(CONTINUABLE_HAS_COROUTINE)
+#  include <coroutine>
+#endif
+
+namespace cti {
+namespace detail {
+namespace awaiting {
+#if defined(CONTINUABLE_HAS_COROUTINE)
+#  if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+using std::experimental::coroutine_handle;
+#  else
+using std::coroutine_handle;
+#  endif
+
+/// Returns the slot of the current thread which takes over the resumption of
+/// the coroutine that is resolved first by a finishing coroutine, such that
+/// it can be resumed through symmetric transfer instead of a nested call.
+inline coroutine_handle<>*& current_resumption_slot() noexcept {
+  static thread_local coroutine_handle<>* slot = nullptr;
+  return slot;
+}
+
+/// Closes the resumption slot of the current thread before a callback
+/// runs, and resumes the coroutine which was passed to the slot before,
+/// such that callbacks observe all coroutines they resolve as resumed.
+inline void close_resumption_slot() {
+  coroutine_handle<>*& slot = current_resumption_slot();
+  if (slot) {
+    coroutine_handle<> pending = std::exchange(*slot, {});
+    slot = nullptr;
+    if (pending) {
+      pending.resume();
+    }
+  }
+}
+
+/// Resumes the given coroutine, or passes it to the resumption slot
+/// of the current thread if the slot is open and empty.
+inline void resume_or_transfer(coroutine_handle<> handle) {
+  coroutine_handle<>* slot = current_resumption_slot();
+  if (slot && !*slot) {
+    *slot = handle;
+  } else {
+    close_resumption_slot();
+    handle.resume();
+  }
+}
+#else
+inline void close_resumption_slot() noexcept {
+}
+#endif // defined(CONTINUABLE_HAS_COROUTINE)
+} // namespace awaiting
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_RESUMPTION_HPP_INCLUDED
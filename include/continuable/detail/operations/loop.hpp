@@ -31,13 +31,19 @@
 #ifndef CONTINUABLE_DETAIL_OPERATIONS_LOOP_HPP_INCLUDED
 #define CONTINUABLE_DETAIL_OPERATIONS_LOOP_HPP_INCLUDED
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <continuable/continuable-base.hpp>
 #include <continuable/continuable-result.hpp>
 #include <continuable/detail/features.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
 #include <continuable/detail/utility/traits.hpp>
 #include <continuable/detail/utility/util.hpp>
 
@@ -70,12 +76,67 @@ struct loop_trait<identity<result<>>> {
 };
 
 namespace operations {
+/// The states of a loop_frame which are used to run iterations that complete
+/// synchronously in a plain loop instead of a recursion, and to pass the
+/// ownership of the frame between the loop and the callback of the running
+/// iteration without any reference counting.
+enum class loop_state : std::uint8_t {
+  /// An iteration is running on the stack of loop_frame::loop,
+  /// which owns the frame.
+  running,
+  /// The running iteration didn't complete synchronously,
+  /// the frame is owned by the callback which completes the iteration.
+  suspended,
+  /// The running iteration completed
+  completed
+};
+
+/// The callback which is attached to the continuable of every iteration.
+///
+/// The callback only carries a pointer to the frame, such that it is stored
+/// without any allocation, even inside a type erased promise.
+template <typename Frame>
+class loop_callback {
+  Frame* frame_;
+
+public:
+  explicit loop_callback(Frame* frame) noexcept : frame_(frame) {
+  }
+  ~loop_callback() {
+    if (frame_) {
+      // The iteration is abandoned without being resolved
+      frame_->complete(false);
+    }
+  }
+
+  loop_callback(loop_callback const&) = delete;
+  loop_callback(loop_callback&& other) noexcept
+      : frame_(std::exchange(other.frame_, nullptr)) {
+  }
+  loop_callback& operator=(loop_callback const&) = delete;
+  loop_callback& operator=(loop_callback&& other) = delete;
+
+  template <typename... Args>
+  void operator()(Args&&... args) {
+    assert(frame_ && "The loop callback was invoked twice!");
+    std::exchange(frame_, nullptr)->resolve(std::forward<Args>(args)...);
+  }
+};
+
+/// The frame of a loop which is allocated once and reused for all iterations
 template <typename Promise, typename Callable, typename ArgsTuple>
-class loop_frame : public std::enable_shared_from_this<
-                       loop_frame<Promise, Callable, ArgsTuple>> {
+class loop_frame {
+  template <typename>
+  friend class loop_callback;
+
   Promise promise_;
   Callable callable_;
   ArgsTuple args_;
+  std::atomic<loop_state> state_{loop_state::running};
+  // Is true when the completed iteration requested the next one
+  bool continue_ = false;
+  // Owns the frame while the running iteration is suspended
+  std::unique_ptr<loop_frame> suspended_;
 
 public:
   explicit loop_frame(Promise promise, Callable callable, ArgsTuple args)
@@ -83,10 +144,39 @@ public:
         args_(std::move(args)) {
   }
 
-  void loop() {
-    // MSVC can't evaluate this inside the lambda capture
-    auto me = this->shared_from_this();
+  /// Runs iterations until one of them doesn't complete synchronously,
+  /// such that the stack depth stays constant regardless of how many
+  /// iterations complete inline.
+  static void loop(std::unique_ptr<loop_frame> frame) {
+    for (;;) {
+      loop_frame* const current = frame.get();
+      current->state_.store(loop_state::running, std::memory_order_relaxed);
 
+      current->iterate();
+
+      // Hand the frame over to the callback before publishing the suspension,
+      // since the callback can complete the iteration concurrently afterwards.
+      current->suspended_ = std::move(frame);
+
+      loop_state expected = loop_state::running;
+      if (current->state_.compare_exchange_strong(
+              expected, loop_state::suspended, std::memory_order_acq_rel,
+              std::memory_order_acquire)) {
+        return;
+      }
+
+      assert(expected == loop_state::completed);
+      frame = std::move(current->suspended_);
+
+      if (!current->continue_) {
+        // The loop is finished, this releases the frame
+        return;
+      }
+    }
+  }
+
+private:
+  void iterate() {
     traits::unpack(
         [&](auto&&... args) mutable {
 
@@ -95,13 +185,11 @@ public:
 #endif // CONTINUABLE_HAS_EXCEPTIONS
 
             util::invoke(callable_, std::forward<decltype(args)>(args)...)
-                .next([me = std::move(me)](auto&&... args) {
-                  me->resolve(std::forward<decltype(args)>(args)...);
-                });
+                .next(loop_callback<loop_frame>(this));
 
 #if defined(CONTINUABLE_HAS_EXCEPTIONS)
           } catch (...) {
-            me->resolve(exception_arg_t{}, std::current_exception());
+            resolve(exception_arg_t{}, std::current_exception());
           }
 #endif // CONTINUABLE_HAS_EXCEPTIONS
         },
@@ -111,18 +199,37 @@ public:
   template <typename Result>
   void resolve(Result&& result) {
     if (result.is_empty()) {
-      loop();
+      complete(true);
     } else if (result.is_value()) {
       traits::unpack(std::move(promise_), std::forward<Result>(result));
+      complete(false);
     } else {
       assert(result.is_exception());
       std::move(promise_).set_exception(
           std::forward<Result>(result).get_exception());
+      complete(false);
     }
   }
 
   void resolve(exception_arg_t, exception_t exception) {
     promise_.set_exception(std::move(exception));
+    complete(false);
+  }
+
+  /// Completes the running iteration and continues the loop if requested
+  void complete(bool next) {
+    continue_ = next;
+
+    if (state_.exchange(loop_state::completed, std::memory_order_acq_rel) ==
+        loop_state::running) {
+      // The loop which is still on the stack continues or finishes
+      return;
+    }
+
+    std::unique_ptr<loop_frame> frame = std::move(suspended_);
+    if (next) {
+      loop(std::move(frame));
+    }
   }
 };
 
@@ -133,7 +240,7 @@ auto make_loop_frame(Promise&& promise, Callable&& callable,
       loop_frame<traits::unrefcv_t<Promise>, traits::unrefcv_t<Callable>,
                  traits::unrefcv_t<ArgsTuple>>;
 
-  return std::make_shared<frame_t>(std::forward<Promise>(promise),
+  return std::make_unique<frame_t>(std::forward<Promise>(promise),
                                    std::forward<Callable>(callable),
                                    std::forward<ArgsTuple>(args_tuple));
 }
@@ -153,7 +260,8 @@ auto loop(Callable&& callable, Args&&... args) {
     // Do the actual looping
     auto frame = make_loop_frame(std::forward<decltype(promise)>(promise),
                                  std::move(callable), std::move(args));
-    frame->loop();
+    using frame_t = typename decltype(frame)::element_type;
+    frame_t::loop(std::move(frame));
   });
 }
 
@@ -173,6 +281,147 @@ auto make_range_looper(Callable&& callable, Begin&& begin, End&& end) {
         });
   };
 }
+
+/// The shared frame of a concurrent range loop, which keeps up to a given
+/// count of iterations in flight.
+///
+/// The iterator is only accessed by the callback which requested launches
+/// while no other launches were pending, so the range is advanced by a single
+/// thread at any time and iterations completing synchronously don't recurse.
+template <typename Promise, typename Callable, typename Begin, typename End>
+class concurrent_loop_frame
+    : public util::ref_counted<
+          concurrent_loop_frame<Promise, Callable, Begin, End>> {
+
+  Promise promise_;
+  Callable callable_;
+  Begin begin_;
+  End end_;
+  // Is only accessed by the thread which performs the launches
+  bool exhausted_ = false;
+  // The count of launches which were requested but not performed yet
+  std::atomic<std::size_t> requested_{0U};
+  // The count of running iterations, plus one until the range is exhausted
+  std::atomic<std::size_t> outstanding_{1U};
+  std::atomic<bool> failed_{false};
+  exception_t exception_;
+
+public:
+  explicit concurrent_loop_frame(Promise promise, Callable callable,
+                                 Begin begin, End end)
+      : promise_(std::move(promise)), callable_(std::move(callable)),
+        begin_(std::move(begin)), end_(std::move(end)) {
+  }
+
+  /// Launches the first limit iterations, a limit of 0 is treated as 1
+  /// since the loop would never complete otherwise.
+  void start(std::size_t limit) {
+    request((std::max)(limit, std::size_t(1U)));
+  }
+
+  template <typename... Args>
+  void resolve(Args&&...) {
+    // Replace the completed iteration by the next one
+    request(1U);
+    release();
+  }
+
+  void resolve(exception_arg_t, exception_t exception) {
+    fail(std::move(exception));
+    // The launch observes the failure and stops the loop
+    request(1U);
+    release();
+  }
+
+private:
+  void request(std::size_t count) {
+    if (requested_.fetch_add(count, std::memory_order_acq_rel) != 0U) {
+      // The launches are performed by the thread which is launching already
+      return;
+    }
+
+    for (;;) {
+      for (std::size_t i = 0U; i != count; ++i) {
+        launch();
+      }
+
+      count = requested_.fetch_sub(count, std::memory_order_acq_rel) - count;
+      if (count == 0U) {
+        return;
+      }
+    }
+  }
+
+  void launch() {
+    if (exhausted_) {
+      return;
+    }
+
+    if (failed_.load(std::memory_order_acquire) || (begin_ == end_)) {
+      // Stop launching iterations and release the reference of the range
+      exhausted_ = true;
+      release();
+      return;
+    }
+
+    outstanding_.fetch_add(1U, std::memory_order_relaxed);
+
+    // MSVC can't evaluate this inside the lambda capture
+    auto me = util::ref_of(this);
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    try {
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+      util::invoke(callable_, begin_)
+          .next([me = std::move(me)](auto&&... args) {
+            me->resolve(std::forward<decltype(args)>(args)...);
+          });
+
+#if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    } catch (...) {
+      resolve(exception_arg_t{}, std::current_exception());
+    }
+#endif // CONTINUABLE_HAS_EXCEPTIONS
+
+    ++begin_;
+  }
+
+  void fail(exception_t exception) {
+    if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+      exception_ = std::move(exception);
+    }
+  }
+
+  void release() {
+    if (outstanding_.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+      if (failed_.load(std::memory_order_relaxed)) {
+        std::move(promise_).set_exception(std::move(exception_));
+      } else {
+        std::move(promise_).set_value();
+      }
+    }
+  }
+};
+
+template <typename Callable, typename Begin, typename End>
+auto loop_concurrent(Callable&& callable, Begin&& begin, End&& end,
+                     std::size_t limit) {
+  return make_continuable<void>(
+      [callable = std::forward<Callable>(callable),
+       begin = std::forward<Begin>(begin), end = std::forward<End>(end),
+       limit](auto&& promise) mutable {
+        using frame_t =
+            concurrent_loop_frame<traits::unrefcv_t<decltype(promise)>,
+                                  std::decay_t<Callable>, std::decay_t<Begin>,
+                                  std::decay_t<End>>;
+
+        auto frame = util::make_ref<frame_t>(
+            std::forward<decltype(promise)>(promise), std::move(callable),
+            std::move(begin), std::move(end));
+        frame->start(limit);
+      });
+}
 } // namespace operations
 } // namespace detail
 } // namespace cti
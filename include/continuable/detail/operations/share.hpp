@@ -0,0 +1,347 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_OPERATIONS_SHARE_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_OPERATIONS_SHARE_HPP_INCLUDED
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <continuable/continuable-primitives.hpp>
+#include <continuable/continuable-result.hpp>
+#include <continuable/detail/core/types.hpp>
+#include <continuable/detail/utility/identity.hpp>
+#include <continuable/detail/utility/intrusive-queue.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
+#include <continuable/detail/utility/traits.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+namespace cti {
+template <typename... Args>
+class shared_continuable;
+
+namespace detail {
+namespace operations {
+/// Passes the cached result to the given callback as const lvalue,
+/// such that the result is copied at most once into every consumer.
+template <typename Callback, typename... Args>
+void resolve_shared(Callback&& callback, result<Args...> const& value) {
+  if (value.is_value()) {
+    traits::unpack(std::forward<Callback>(callback), value);
+  } else if (value.is_exception()) {
+    std::forward<Callback>(callback)(exception_arg_t{}, value.get_exception());
+  } else {
+    std::forward<Callback>(callback)(exception_arg_t{}, exception_t{});
+  }
+}
+
+/// Is true when the callback can be invoked with the cached result as const
+/// lvalue references, which is true for all callbacks which don't require
+/// rvalue references. Otherwise the result is copied into the callback chain
+/// before the callback is invoked.
+template <typename Callback, typename... Args>
+using accepts_shared_t = std::integral_constant<
+    bool, traits::is_invocable<std::decay_t<Callback>, Args const&...>::value ||
+              !traits::is_invocable<std::decay_t<Callback>, Args&&...>::value>;
+
+/// A callback which waits for the result of a shared_state
+template <typename... Args>
+class shared_subscriber {
+public:
+  shared_subscriber* next = nullptr;
+
+  virtual ~shared_subscriber() = default;
+
+  virtual void resolve(result<Args...> const& value) = 0;
+};
+
+template <typename Callback, typename... Args>
+class shared_subscriber_of final : public shared_subscriber<Args...> {
+  Callback callback_;
+
+public:
+  explicit shared_subscriber_of(Callback callback)
+      : callback_(std::move(callback)) {
+  }
+
+  void resolve(result<Args...> const& value) override {
+    resolve_shared(std::move(callback_), value);
+  }
+};
+
+/// The state of a shared_continuable which starts the underlying
+/// continuation on the first subscription and caches its result.
+///
+/// Subscribers which arrive before the result are linked into an intrusive
+/// queue in order, such that their node is the only allocation.
+/// Subscribers which arrive afterwards are resolved immediately without
+/// any allocation and without acquiring the lock.
+template <typename... Args>
+class shared_state : public util::ref_counted<shared_state<Args...>> {
+  using subscriber_t = shared_subscriber<Args...>;
+
+  std::atomic<bool> resolved_{false};
+  std::mutex lock_;
+  bool started_ = false;
+  util::intrusive_queue<subscriber_t> subscribers_;
+  result<Args...> result_;
+
+public:
+  shared_state() = default;
+  explicit shared_state(result<Args...> value)
+      : resolved_(true), started_(true), result_(std::move(value)) {
+  }
+
+  virtual ~shared_state() {
+    while (subscriber_t* current = subscribers_.pop_front()) {
+      delete current;
+    }
+  }
+
+  template <typename Callback>
+  void subscribe(Callback&& callback) {
+    if (resolved_.load(std::memory_order_acquire)) {
+      resolve_shared(std::forward<Callback>(callback), result_);
+      return;
+    }
+
+    using node_t = shared_subscriber_of<traits::unrefcv_t<Callback>, //
+                                        Args...>;
+    std::unique_ptr<subscriber_t> subscriber(
+        new node_t(std::forward<Callback>(callback)));
+
+    std::unique_lock<std::mutex> lock(lock_);
+    if (resolved_.load(std::memory_order_relaxed)) {
+      lock.unlock();
+      subscriber->resolve(result_);
+      return;
+    }
+
+    subscribers_.push_back(subscriber.release());
+
+    bool const start = !std::exchange(started_, true);
+    lock.unlock();
+
+    if (start) {
+      this->start();
+    }
+  }
+
+  /// Stores the result and resolves all queued subscribers
+  void resolve(result<Args...>&& value) {
+    util::intrusive_queue<subscriber_t> subscribers;
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      assert(!resolved_.load(std::memory_order_relaxed));
+      result_ = std::move(value);
+      resolved_.store(true, std::memory_order_release);
+      std::swap(subscribers, subscribers_);
+    }
+
+    // The result isn't mutated anymore, hence the subscribers
+    // can read it without holding the lock.
+    while (subscriber_t* current = subscribers.pop_front()) {
+      std::unique_ptr<subscriber_t> owned(current);
+      owned->resolve(result_);
+    }
+  }
+
+  bool is_ready() const noexcept {
+    return resolved_.load(std::memory_order_acquire);
+  }
+
+  /// Returns the cached result, which is only valid after the state
+  /// was resolved.
+  result<Args...> const& get() const noexcept {
+    assert(is_ready());
+    return result_;
+  }
+
+private:
+  virtual void start() = 0;
+};
+
+/// A callback which passes the completion of the shared_state to the
+/// given callback without the values of the result, such that they aren't
+/// copied into the callback chain. The values are read from the state by
+/// the shared_consumer instead.
+template <typename Callback>
+class shared_signal {
+  Callback callback_;
+
+public:
+  explicit shared_signal(Callback callback) : callback_(std::move(callback)) {
+  }
+
+  template <typename... Values>
+  void operator()(Values&&...) && {
+    std::move(callback_)();
+  }
+  void operator()(exception_arg_t tag, exception_t exception) && {
+    std::move(callback_)(tag, std::move(exception));
+  }
+};
+
+/// Invokes the callback with const lvalue references to the values of
+/// the shared result, the shared_state is kept alive until the callback
+/// was invoked, which might happen later on an arbitrary executor.
+template <typename Callback, typename... Args>
+class shared_consumer {
+  util::ref_ptr<shared_state<Args...>> state_;
+  Callback callback_;
+
+public:
+  explicit shared_consumer(util::ref_ptr<shared_state<Args...>> state,
+                           Callback callback)
+      : state_(std::move(state)), callback_(std::move(callback)) {
+  }
+
+  auto operator()() && {
+    return traits::unpack(
+        [&](auto const&... values) {
+          return util::partial_invoke(std::integral_constant<std::size_t, 0U>{},
+                                      std::move(callback_), values...);
+        },
+        state_->get());
+  }
+  auto operator()(exception_arg_t tag, exception_t exception) && {
+    return util::partial_invoke(std::integral_constant<std::size_t, 1U>{},
+                                std::move(callback_), tag,
+                                std::move(exception));
+  }
+};
+
+/// Resolves the shared_state with the result of the source continuation,
+/// the state is resolved with an empty result when the callback is dropped.
+template <typename... Args>
+class shared_resolver {
+  util::ref_ptr<shared_state<Args...>> state_;
+  util::ownership ownership_;
+
+public:
+  explicit shared_resolver(util::ref_ptr<shared_state<Args...>> state)
+      : state_(std::move(state)) {
+  }
+
+  shared_resolver(shared_resolver const&) = delete;
+  shared_resolver(shared_resolver&&) = default;
+  shared_resolver& operator=(shared_resolver const&) = delete;
+  shared_resolver& operator=(shared_resolver&&) = default;
+
+  ~shared_resolver() {
+    resolve(result<Args...>::empty());
+  }
+
+  template <typename... Values>
+  void operator()(Values&&... values) {
+    resolve(result<Args...>::from(std::forward<Values>(values)...));
+  }
+
+private:
+  void resolve(result<Args...>&& value) {
+    if (!ownership_.is_acquired()) {
+      return;
+    }
+    ownership_.release();
+
+    state_->resolve(std::move(value));
+  }
+};
+
+/// The shared_state which owns the source continuation until it's started
+template <typename Continuable, typename... Args>
+class shared_source final : public shared_state<Args...> {
+  Continuable source_;
+
+public:
+  explicit shared_source(Continuable&& source) : source_(std::move(source)) {
+    source_.freeze();
+  }
+
+private:
+  void start() override {
+    std::move(source_).next(shared_resolver<Args...>(util::ref_of(
+        static_cast<shared_state<Args...>*>(this))))
+        .done();
+  }
+};
+
+/// The shared_state which is constructed from an available result
+template <typename... Args>
+class shared_ready final : public shared_state<Args...> {
+public:
+  explicit shared_ready(result<Args...> value)
+      : shared_state<Args...>(std::move(value)) {
+  }
+
+private:
+  void start() override {
+    // The state is resolved already and never started
+  }
+};
+
+template <typename Hint>
+struct shared_trait;
+template <typename... Args>
+struct shared_trait<identity<Args...>> {
+  using ready_t = shared_ready<Args...>;
+  using shared_t = shared_continuable<Args...>;
+  using result_t = result<Args...>;
+
+  template <typename Continuable>
+  using source_t = shared_source<Continuable, Args...>;
+};
+
+/// Transforms the given continuable into a shared_continuable
+template <typename Data, typename Annotation>
+auto share(continuable_base<Data, Annotation>&& continuable) {
+  using trait_t = shared_trait<Annotation>;
+  using ready_t = typename trait_t::ready_t;
+  using shared_t = typename trait_t::shared_t;
+
+  // A ready continuable is unpacked immediately since this is side-effect
+  // free, there is no need to keep the continuation alive then.
+  if (continuable.is_ready()) {
+    return shared_t(util::make_ref<ready_t>(std::move(continuable).unpack()));
+  }
+
+  using source_t = typename trait_t::template source_t<
+      continuable_base<Data, Annotation>>;
+  return shared_t(util::make_ref<source_t>(std::move(continuable)));
+}
+} // namespace operations
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_OPERATIONS_SHARE_HPP_INCLUDED
@@ -31,7 +31,9 @@
 #ifndef CONTINUABLE_DETAIL_OPERATIONS_SPLIT_HPP_INCLUDED
 #define CONTINUABLE_DETAIL_OPERATIONS_SPLIT_HPP_INCLUDED
 
+#include <memory>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <continuable/continuable-base.hpp>
 #include <continuable/continuable-traverse.hpp>
@@ -57,7 +59,20 @@ struct operator_bool_or<T, Else,
   }
 };
 
-template <typename First, typename... Promises>
+/// Passes an argument to all promises except the one which is resolved last
+template <typename T>
+T& split_argument(std::false_type, T& arg) noexcept {
+  return arg;
+}
+template <typename T>
+T const& split_argument(std::true_type, T& arg) noexcept {
+  return arg;
+}
+
+/// Resolves all promises with the arguments, the first promise is resolved
+/// last with the forwarded arguments. All other promises receive those as
+/// lvalues, which are const if AsConst is true.
+template <bool AsConst, typename First, typename... Promises>
 class split_promise {
   First first_;
   std::tuple<Promises...> promises_;
@@ -74,7 +89,8 @@ public:
           using accessor =
               operator_bool_or<traits::unrefcv_t<decltype(promise)>, true>;
           if (accessor::get(promise)) {
-            std::forward<decltype(promise)>(promise)(args...);
+            std::forward<decltype(promise)>(promise)(split_argument(
+                std::integral_constant<bool, AsConst>{}, args)...);
           }
         },
         std::move(promises_));
@@ -111,6 +127,76 @@ public:
     return is_valid;
   }
 };
+
+/// Wraps the given argument into an immutable and reference counted holder
+template <typename T>
+auto share_argument(T&& arg) {
+  return std::make_shared<std::add_const_t<std::decay_t<T>>>(
+      std::forward<T>(arg));
+}
+
+template <typename... Promises>
+class shared_split_promise {
+  std::tuple<Promises...> promises_;
+
+public:
+  explicit shared_split_promise(Promises... promises)
+      : promises_(std::move(promises)...) {
+  }
+
+  /// Wraps every argument once into a std::shared_ptr to a const object
+  /// and passes a handle to it to every promise.
+  template <typename... Args>
+  void operator()(Args&&... args) && {
+    std::move(*this).dispatch(share_argument(std::forward<Args>(args))...);
+  }
+
+  /// Passes the exception unchanged to every promise
+  void operator()(exception_arg_t tag, exception_t exception) && {
+    std::move(*this).dispatch(tag, std::move(exception));
+  }
+
+  template <typename... Args>
+  void set_value(Args... args) noexcept {
+    std::move(*this)(std::move(args)...);
+  }
+
+  void set_exception(exception_t error) noexcept {
+    std::move(*this)(exception_arg_t{}, std::move(error));
+  }
+
+  void set_canceled() noexcept {
+    std::move(*this)(exception_arg_t{}, exception_t{});
+  }
+
+  explicit operator bool() const noexcept {
+    bool is_valid = false;
+    traverse_pack(
+        [&](auto&& promise) mutable -> void {
+          using accessor =
+              operator_bool_or<traits::unrefcv_t<decltype(promise)>, true>;
+          if (!is_valid && accessor::get(promise)) {
+            is_valid = true;
+          }
+        },
+        promises_);
+    return is_valid;
+  }
+
+private:
+  template <typename... Handles>
+  void dispatch(Handles&&... handles) && {
+    traverse_pack(
+        [&](auto&& promise) mutable -> void {
+          using accessor =
+              operator_bool_or<traits::unrefcv_t<decltype(promise)>, true>;
+          if (accessor::get(promise)) {
+            std::forward<decltype(promise)>(promise)(handles...);
+          }
+        },
+        std::move(promises_));
+  }
+};
 } // namespace operations
 } // namespace detail
 } // namespace cti
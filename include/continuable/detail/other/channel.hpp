@@ -0,0 +1,408 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_CHANNEL_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_CHANNEL_HPP_INCLUDED
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <continuable/continuable-primitives.hpp>
+#include <continuable/continuable-result.hpp>
+#include <continuable/detail/utility/intrusive-queue.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
+#include <continuable/detail/utility/traits.hpp>
+
+namespace cti {
+namespace detail {
+namespace channel {
+/// The assumed size of a cache line, which is used to keep the positions
+/// of the producers and consumers apart.
+constexpr std::size_t cache_line_size = 64U;
+
+/// A bounded multi-producer multi-consumer queue which doesn't
+/// require any lock, every cell carries a sequence number which
+/// tells whether it's free for the producer or the consumer
+/// of the current round.
+///
+/// A cell is free for the producer at position pos when its sequence is
+/// equal to 2 * pos, and it is ready for the consumer when its sequence
+/// is equal to 2 * pos + 1, which keeps both states apart also for
+/// a buffer with a capacity of one.
+template <typename T>
+class ring_buffer {
+  struct cell {
+    std::atomic<std::size_t> sequence;
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+  };
+
+  std::size_t const capacity_;
+  std::unique_ptr<cell[]> cells_;
+  alignas(cache_line_size) std::atomic<std::size_t> head_{0U};
+  alignas(cache_line_size) std::atomic<std::size_t> tail_{0U};
+
+public:
+  explicit ring_buffer(std::size_t capacity)
+      : capacity_(capacity), cells_(new cell[capacity]) {
+    assert(capacity_ > 0U && "The capacity of a channel must not be zero!");
+    for (std::size_t i = 0U; i < capacity_; ++i) {
+      cells_[i].sequence.store(2U * i, std::memory_order_relaxed);
+    }
+  }
+  ~ring_buffer() {
+    std::size_t const tail = tail_.load(std::memory_order_relaxed);
+    for (std::size_t pos = head_.load(std::memory_order_relaxed); pos != tail;
+         ++pos) {
+      value_of(cells_[pos % capacity_])->~T();
+    }
+  }
+
+  ring_buffer(ring_buffer const&) = delete;
+  ring_buffer(ring_buffer&&) = delete;
+  ring_buffer& operator=(ring_buffer const&) = delete;
+  ring_buffer& operator=(ring_buffer&&) = delete;
+
+  std::size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  /// Stores the value and returns true, the value isn't moved
+  /// when the buffer is full.
+  bool try_push(T& value) {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell& current = cells_[pos % capacity_];
+      std::size_t const sequence =
+          current.sequence.load(std::memory_order_acquire);
+
+      if (sequence == 2U * pos) {
+        if (tail_.compare_exchange_weak(pos, pos + 1U,
+                                        std::memory_order_relaxed)) {
+          new (&current.storage) T(std::move(value));
+          current.sequence.store(2U * pos + 1U, std::memory_order_release);
+          return true;
+        }
+      } else if (static_cast<std::ptrdiff_t>(sequence - 2U * pos) < 0) {
+        // The cell still holds the value of the previous round
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Moves the oldest value into the given result and returns true,
+  /// when the buffer isn't empty.
+  bool try_pop(result<T>& value) {
+    std::size_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell& current = cells_[pos % capacity_];
+      std::size_t const sequence =
+          current.sequence.load(std::memory_order_acquire);
+
+      if (sequence == 2U * pos + 1U) {
+        if (head_.compare_exchange_weak(pos, pos + 1U,
+                                        std::memory_order_relaxed)) {
+          T* stored = value_of(current);
+          value.set_value(std::move(*stored));
+          stored->~T();
+          current.sequence.store(2U * (pos + capacity_),
+                                 std::memory_order_release);
+          return true;
+        }
+      } else if (static_cast<std::ptrdiff_t>(sequence - (2U * pos + 1U)) <
+                 0) {
+        // The cell wasn't written in this round yet
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  static T* value_of(cell& current) noexcept {
+    return reinterpret_cast<T*>(&current.storage);
+  }
+};
+
+/// A sender which is parked until its value can be passed to the channel
+template <typename T>
+class send_waiter {
+public:
+  send_waiter* next = nullptr;
+  T value;
+
+  explicit send_waiter(T value_) : value(std::move(value_)) {
+  }
+  virtual ~send_waiter() = default;
+
+  send_waiter(send_waiter const&) = delete;
+  send_waiter& operator=(send_waiter const&) = delete;
+
+  /// Is called when the value was taken
+  virtual void resolve() = 0;
+  /// Is called when the channel was destroyed
+  virtual void cancel() = 0;
+};
+
+template <typename Callback, typename T>
+class send_waiter_of final : public send_waiter<T> {
+  Callback callback_;
+
+public:
+  explicit send_waiter_of(Callback callback, T value)
+      : send_waiter<T>(std::move(value)), callback_(std::move(callback)) {
+  }
+
+  void resolve() override {
+    std::move(callback_)();
+  }
+
+  void cancel() override {
+    std::move(callback_)(exception_arg_t{}, exception_t{});
+  }
+};
+
+/// A receiver which is parked until a value arrives in the channel
+template <typename T>
+class receive_waiter {
+public:
+  receive_waiter* next = nullptr;
+  /// Holds the value which is passed to the receiver on resolution
+  result<T> value;
+
+  receive_waiter() = default;
+  virtual ~receive_waiter() = default;
+
+  receive_waiter(receive_waiter const&) = delete;
+  receive_waiter& operator=(receive_waiter const&) = delete;
+
+  /// Is called when the value was assigned
+  virtual void resolve() = 0;
+  /// Is called when the channel was destroyed
+  virtual void cancel() = 0;
+};
+
+template <typename Callback, typename T>
+class receive_waiter_of final : public receive_waiter<T> {
+  Callback callback_;
+
+public:
+  explicit receive_waiter_of(Callback callback)
+      : callback_(std::move(callback)) {
+  }
+
+  void resolve() override {
+    std::move(callback_)(std::move(this->value).get_value());
+  }
+
+  void cancel() override {
+    std::move(callback_)(exception_arg_t{}, exception_t{});
+  }
+};
+
+/// The waiters which were settled while the lock was held,
+/// those are resolved after the lock was released.
+template <typename T>
+struct settled_waiters {
+  util::intrusive_queue<send_waiter<T>> senders;
+  util::intrusive_queue<receive_waiter<T>> receivers;
+
+  settled_waiters() = default;
+  ~settled_waiters() {
+    while (send_waiter<T>* sender = senders.pop_front()) {
+      sender->resolve();
+      delete sender;
+    }
+    while (receive_waiter<T>* receiver = receivers.pop_front()) {
+      receiver->resolve();
+      delete receiver;
+    }
+  }
+
+  settled_waiters(settled_waiters const&) = delete;
+  settled_waiters& operator=(settled_waiters const&) = delete;
+};
+
+/// The shared state of a channel.
+///
+/// Values are passed through the lock-free ring buffer, senders and
+/// receivers which can't complete immediately are parked inside
+/// intrusive queues which are guarded by a lock. The count of parked
+/// waiters is published before the parking operation retries the buffer,
+/// hence an operation on the other side either sees the parked waiter,
+/// or the parking operation sees the result of the other side.
+template <typename T>
+class channel_state : public util::ref_counted<channel_state<T>> {
+  ring_buffer<T> buffer_;
+  std::atomic<std::size_t> parked_senders_{0U};
+  std::atomic<std::size_t> parked_receivers_{0U};
+  std::mutex lock_;
+  util::intrusive_queue<send_waiter<T>> senders_;
+  util::intrusive_queue<receive_waiter<T>> receivers_;
+
+public:
+  explicit channel_state(std::size_t capacity) : buffer_(capacity) {
+  }
+
+  ~channel_state() {
+    while (send_waiter<T>* sender = senders_.pop_front()) {
+      sender->cancel();
+      delete sender;
+    }
+    while (receive_waiter<T>* receiver = receivers_.pop_front()) {
+      receiver->cancel();
+      delete receiver;
+    }
+  }
+
+  std::size_t capacity() const noexcept {
+    return buffer_.capacity();
+  }
+
+  template <typename Callback>
+  void send(Callback&& callback, T value) {
+    if (buffer_.try_push(value)) {
+      wake_if_parked(parked_receivers_);
+      std::forward<Callback>(callback)();
+      return;
+    }
+
+    settled_waiters<T> settled;
+    std::unique_lock<std::mutex> lock(lock_);
+    parked_senders_.fetch_add(1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (buffer_.try_push(value)) {
+      parked_senders_.fetch_sub(1U, std::memory_order_relaxed);
+      settle(settled);
+      lock.unlock();
+
+      std::forward<Callback>(callback)();
+      return;
+    }
+
+    using waiter_t = send_waiter_of<traits::unrefcv_t<Callback>, T>;
+    senders_.push_back(
+        new waiter_t(std::forward<Callback>(callback), std::move(value)));
+    settle(settled);
+  }
+
+  template <typename Callback>
+  void receive(Callback&& callback) {
+    result<T> value;
+    if (buffer_.try_pop(value)) {
+      wake_if_parked(parked_senders_);
+      std::forward<Callback>(callback)(std::move(value).get_value());
+      return;
+    }
+
+    settled_waiters<T> settled;
+    std::unique_lock<std::mutex> lock(lock_);
+    parked_receivers_.fetch_add(1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (buffer_.try_pop(value)) {
+      parked_receivers_.fetch_sub(1U, std::memory_order_relaxed);
+      settle(settled);
+      lock.unlock();
+
+      std::forward<Callback>(callback)(std::move(value).get_value());
+      return;
+    }
+
+    using waiter_t = receive_waiter_of<traits::unrefcv_t<Callback>, T>;
+    receivers_.push_back(new waiter_t(std::forward<Callback>(callback)));
+    settle(settled);
+  }
+
+private:
+  /// Settles the parked waiters of the other side after an operation
+  /// completed through the buffer without acquiring the lock.
+  void wake_if_parked(std::atomic<std::size_t> const& parked) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked.load(std::memory_order_relaxed) == 0U) {
+      return;
+    }
+
+    settled_waiters<T> settled;
+    std::lock_guard<std::mutex> lock(lock_);
+    settle(settled);
+  }
+
+  /// Moves values from the buffer to parked receivers and from parked
+  /// senders to the buffer until no waiter can make progress anymore.
+  void settle(settled_waiters<T>& settled) {
+    for (bool progress = true; progress;) {
+      progress = false;
+
+      if (receive_waiter<T>* receiver = receivers_.front()) {
+        if (buffer_.try_pop(receiver->value)) {
+          settle_receiver(settled);
+          progress = true;
+        } else if (send_waiter<T>* sender = senders_.front()) {
+          // Hand the value over directly
+          receiver->value.set_value(std::move(sender->value));
+          settle_sender(settled);
+          settle_receiver(settled);
+          progress = true;
+        }
+      }
+
+      if (send_waiter<T>* sender = senders_.front()) {
+        if (buffer_.try_push(sender->value)) {
+          settle_sender(settled);
+          progress = true;
+        }
+      }
+    }
+  }
+
+  void settle_sender(settled_waiters<T>& settled) noexcept {
+    settled.senders.push_back(senders_.pop_front());
+    parked_senders_.fetch_sub(1U, std::memory_order_relaxed);
+  }
+
+  void settle_receiver(settled_waiters<T>& settled) noexcept {
+    settled.receivers.push_back(receivers_.pop_front());
+    parked_receivers_.fetch_sub(1U, std::memory_order_relaxed);
+  }
+};
+} // namespace channel
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_CHANNEL_HPP_INCLUDED
@@ -32,14 +32,24 @@
 #ifndef CONTINUABLE_DETAIL_AWAITING_HPP_INCLUDED
 #define CONTINUABLE_DETAIL_AWAITING_HPP_INCLUDED
 
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <memory>
 #include <type_traits>
+#include <utility>
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/continuable-result.hpp>
+#include <continuable/continuable-traverse.hpp>
+#include <continuable/detail/connection/connection-aggregated.hpp>
+#include <continuable/detail/connection/connection-all.hpp>
 #include <continuable/detail/core/annotation.hpp>
 #include <continuable/detail/core/base.hpp>
+#include <continuable/detail/core/resumption.hpp>
 #include <continuable/detail/core/types.hpp>
 #include <continuable/detail/features.hpp>
+#include <continuable/detail/other/frame-pool.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
 #include <continuable/detail/utility/traits.hpp>
 #include <continuable/detail/utility/util.hpp>
 
@@ -60,9 +70,13 @@ namespace awaiting {
 /// We import the coroutine handle in our namespace
 #  if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
 using std::experimental::coroutine_handle;
+using std::experimental::noop_coroutine;
+using std::experimental::suspend_always;
 using std::experimental::suspend_never;
 #  else
 using std::coroutine_handle;
+using std::noop_coroutine;
+using std::suspend_always;
 using std::suspend_never;
 #  endif
 
@@ -77,6 +91,30 @@ public:
 };
 #  endif // CONTINUABLE_HAS_EXCEPTIONS
 
+/// Opens the resumption slot of the current thread for its lifetime
+class resumption_scope {
+  coroutine_handle<> handle_;
+  coroutine_handle<>* previous_;
+
+public:
+  resumption_scope() noexcept
+    : previous_(std::exchange(current_resumption_slot(), &handle_)) {}
+  ~resumption_scope() {
+    current_resumption_slot() = previous_;
+  }
+
+  resumption_scope(resumption_scope const&) = delete;
+  resumption_scope& operator=(resumption_scope const&) = delete;
+
+  /// Returns the coroutine which was passed to the slot or a noop coroutine
+  coroutine_handle<> target() const noexcept {
+    if (handle_) {
+      return handle_;
+    }
+    return noop_coroutine();
+  }
+};
+
 template <typename T>
 struct result_from_identity;
 template <typename... T>
@@ -84,18 +122,46 @@ struct result_from_identity<identity<T...>> {
   using result_t = result<T...>;
 };
 
+/// Returns the value of the given result, or rethrows its exception
+template <typename Result>
+typename Result::value_t unpack_await_result(Result result) {
+  if (result.is_value()) {
+    // When the result was resolved return it
+    return std::move(result).get_value();
+  }
+
+  assert(result.is_exception());
+
+#  if defined(CONTINUABLE_HAS_EXCEPTIONS)
+  if (exception_t e = result.get_exception()) {
+    std::rethrow_exception(std::move(e));
+  } else {
+    throw await_canceled_exception();
+  }
+#  else  // CONTINUABLE_HAS_EXCEPTIONS
+  // Returning error types from co_await isn't supported!
+  CTI_DETAIL_TRAP();
+#  endif // CONTINUABLE_HAS_EXCEPTIONS
+}
+
 /// An object which provides the internal buffer and helper methods
 /// for waiting on a continuable in a stackless coroutine.
 template <typename Continuable>
 class awaitable {
+protected:
   using hint_t = decltype(base::annotation_of(identify<Continuable>{}));
   using result_t = typename result_from_identity<hint_t>::result_t;
 
+private:
   /// The continuable which is invoked upon suspension
   Continuable continuable_;
+
+protected:
   /// A cache which is used to pass the result of the continuation
   /// to the coroutine.
   result_t result_;
+
+private:
   /// Enumeration that represents the suspension state of the awaitable.
   enum class state : std::uint8_t {
     suspended,
@@ -141,34 +207,206 @@ public:
           // chain.
           if (state_.exchange(state::resolved, std::memory_order_acq_rel) ==
               state::suspended) {
-            return h.resume();
+            resume_or_transfer(h);
           }
         })
         .done();
 
+    // A continuation which was resolved on the current thread already
+    // resumes the coroutine without suspending it, this requires
+    // no read-modify-write of the state.
+    if (state_.load(std::memory_order_acquire) == state::resolved) {
+      return false;
+    }
     return state_.exchange(state::suspended, std::memory_order_acq_rel) !=
            state::resolved;
   }
 
   /// Resume the coroutine represented by the handle
   typename result_t::value_t await_resume() noexcept(false) {
-    if (result_.is_value()) {
-      // When the result was resolved return it
-      return std::move(result_).get_value();
+    return unpack_await_result(std::move(result_));
+  }
+};
+
+/// The state of an all_awaitable, which stores the partial results, the
+/// count of unsettled continuations and the first error.
+///
+/// The state is shared between the awaitable and the continuations,
+/// since the coroutine is resumed on the first error already while the
+/// remaining continuations still refer to their partial results.
+template <typename Data>
+class all_state : public util::ref_counted<all_state<Data>> {
+  using hint_t =
+      std::decay_t<decltype(connection::aggregated::hint_of_data<Data>())>;
+
+public:
+  using result_t = typename result_from_identity<hint_t>::result_t;
+
+private:
+  /// Is set while the suspending coroutine invokes the continuations
+  static constexpr std::size_t dispatching_bit = ~(~std::size_t(0U) >> 1U);
+  /// Is set by the first continuation which failed
+  static constexpr std::size_t failed_bit = dispatching_bit >> 1U;
+
+  /// The boxed continuations which store the partial results
+  Data data_;
+  /// The count of unsettled continuations and the bits above
+  std::atomic<std::size_t> state_{dispatching_bit};
+  std::atomic<bool> failing_{false};
+  exception_t exception_;
+  coroutine_handle<> handle_;
+
+  template <typename Box>
+  class partial_callback {
+    Box* box_;
+    util::ref_ptr<all_state> me_;
+    util::ownership ownership_;
+
+  public:
+    explicit partial_callback(Box* box, util::ref_ptr<all_state> me) noexcept
+      : box_(box), me_(std::move(me)) {}
+
+    partial_callback(partial_callback const&) = delete;
+    partial_callback(partial_callback&&) = default;
+    partial_callback& operator=(partial_callback const&) = delete;
+    partial_callback& operator=(partial_callback&&) = default;
+
+    /// A dropped continuation is settled as cancelled
+    ~partial_callback() {
+      if (ownership_.is_acquired() && me_) {
+        me_->fail(exception_t{});
+      }
     }
 
-    assert(result_.is_exception());
+    template <typename... Args>
+    void operator()(Args&&... args) && {
+      ownership_.release();
+      box_->assign(std::forward<Args>(args)...);
+      me_->complete_one();
+    }
 
-#  if defined(CONTINUABLE_HAS_EXCEPTIONS)
-    if (exception_t e = result_.get_exception()) {
-      std::rethrow_exception(std::move(e));
-    } else {
-      throw await_canceled_exception();
+    void operator()(exception_arg_t, exception_t exception) && {
+      ownership_.release();
+      me_->fail(std::move(exception));
     }
-#  else  // CONTINUABLE_HAS_EXCEPTIONS
-    // Returning error types from co_await isn't supported!
-    CTI_DETAIL_TRAP();
-#  endif // CONTINUABLE_HAS_EXCEPTIONS
+
+    template <typename... Args>
+    void set_value(Args&&... args) {
+      std::move(*this)(std::forward<Args>(args)...);
+    }
+
+    void set_exception(exception_t exception) {
+      std::move(*this)(exception_arg_t{}, std::move(exception));
+    }
+
+    void set_canceled() {
+      std::move(*this)(exception_arg_t{}, exception_t{});
+    }
+
+    explicit operator bool() const noexcept {
+      return true;
+    }
+  };
+
+  struct dispatcher {
+    all_state* me;
+
+    template <typename Box,
+              std::enable_if_t<connection::aggregated::is_continuable_box<
+                  std::decay_t<Box>>::value>* = nullptr>
+    void operator()(Box&& box) const {
+      me->state_.fetch_add(1U, std::memory_order_relaxed);
+      base::invoke_continuation(
+          box.fetch(), partial_callback<std::decay_t<Box>>(
+                           std::addressof(box), util::ref_of(me)));
+    }
+  };
+
+  void complete_one() {
+    // The last continuation resumes the coroutine, unless it was resumed
+    // by the first error already or it is still dispatching.
+    if (state_.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+      resume_or_transfer(handle_);
+    }
+  }
+
+  void fail(exception_t exception) {
+    if (failing_.exchange(true, std::memory_order_relaxed)) {
+      // The first error resumes the coroutine, the count of this
+      // continuation can't be the last one since the first failing
+      // continuation still holds its own.
+      state_.fetch_sub(1U, std::memory_order_relaxed);
+      return;
+    }
+
+    exception_ = std::move(exception);
+
+    std::size_t current = state_.load(std::memory_order_relaxed);
+    while (!state_.compare_exchange_weak(current, (current - 1U) | failed_bit,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_relaxed)) {
+    }
+    if (!(current & dispatching_bit)) {
+      resume_or_transfer(handle_);
+    }
+  }
+
+public:
+  explicit all_state(Data&& data) : data_(std::move(data)) {}
+
+  /// Invokes all continuations and returns true when the coroutine
+  /// was suspended, which is false when the connection was settled in-place.
+  bool dispatch(coroutine_handle<> handle) {
+    handle_ = handle;
+
+    traverse_pack(dispatcher{this}, data_);
+
+    std::size_t const previous =
+        state_.fetch_and(~dispatching_bit, std::memory_order_acq_rel);
+    return !((previous & failed_bit) || (previous == dispatching_bit));
+  }
+
+  result_t get() {
+    if (state_.load(std::memory_order_acquire) & failed_bit) {
+      return result_t::from(exception_arg_t{}, std::move(exception_));
+    }
+
+    result_t result;
+    connection::aggregated::finalize_data(
+        [&](auto&&... args) {
+          result.set_value(std::forward<decltype(args)>(args)...);
+        },
+        std::move(data_));
+    return result;
+  }
+};
+
+/// An awaitable for an all connection, which invokes the continuations
+/// directly, instead of finalizing the connection into a continuable that
+/// is type erased on the way.
+///
+/// The coroutine is resumed when all continuations were resolved, or
+/// on the first error, like cti::when_all.
+template <typename Data>
+class all_awaitable {
+  using state_t = all_state<Data>;
+
+  util::ref_ptr<state_t> state_;
+
+public:
+  explicit all_awaitable(Data&& data)
+    : state_(util::make_ref<state_t>(std::move(data))) {}
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  bool await_suspend(coroutine_handle<> h) {
+    return state_->dispatch(h);
+  }
+
+  typename state_t::result_t::value_t await_resume() noexcept(false) {
+    return unpack_await_result(state_->get());
   }
 };
 
@@ -176,9 +414,132 @@ public:
 /// the C++ coroutine TS.
 template <typename T>
 constexpr auto create_awaiter(T&& continuable) {
-  return awaitable<std::decay_t<T>>(std::forward<T>(continuable));
+  using continuable_t = decltype(std::forward<T>(continuable).finish());
+  return awaitable<continuable_t>(std::forward<T>(continuable).finish());
+}
+
+/// Converts an all connection into an awaitable which doesn't materialize
+/// the connection.
+template <typename Data>
+auto create_awaiter(
+    continuable_base<Data, connection::connection_strategy_all_tag>&&
+        continuable) {
+  auto data = connection::aggregated::box_continuables(
+      base::attorney::consume(std::move(continuable)));
+  return all_awaitable<decltype(data)>(std::move(data));
 }
 
+/// An awaitable which resumes the coroutine with the result of the
+/// continuation, rather than with its values, hence it never throws.
+template <typename Continuable>
+class result_awaitable : public awaitable<Continuable> {
+public:
+  using awaitable<Continuable>::awaitable;
+
+  /// Resume the coroutine with the result
+  typename awaitable<Continuable>::result_t await_resume() noexcept {
+    assert(!this->result_.is_empty());
+    return std::move(this->result_);
+  }
+};
+
+/// Converts a continuable into an awaitable object which resumes the
+/// coroutine with a result<Args...>.
+template <typename T>
+constexpr auto create_result_awaiter(T&& continuable) {
+  return result_awaitable<std::decay_t<T>>(std::forward<T>(continuable));
+}
+
+/// An awaitable which resumes the coroutine through the given executor,
+/// the work which is passed to the executor consists of a single pointer
+/// to the awaitable inside the suspended coroutine frame.
+template <typename Executor>
+class resume_on_awaitable {
+  Executor executor_;
+  coroutine_handle<> handle_;
+  result<> result_;
+
+  class resume_work {
+    resume_on_awaitable* me_;
+
+    template <typename Resolver>
+    void resume(Resolver&& resolver) noexcept {
+      resume_on_awaitable* me = std::exchange(me_, nullptr);
+      assert(me && "The work was already invoked!");
+      std::forward<Resolver>(resolver)(me->result_);
+      me->handle_.resume();
+    }
+
+  public:
+    explicit resume_work(resume_on_awaitable* me) noexcept : me_(me) {}
+
+    resume_work(resume_work const&) = delete;
+    resume_work(resume_work&& other) noexcept
+      : me_(std::exchange(other.me_, nullptr)) {}
+    resume_work& operator=(resume_work const&) = delete;
+    resume_work& operator=(resume_work&&) = delete;
+
+    /// Work which is dropped by the executor resumes the coroutine
+    /// through a cancellation.
+    ~resume_work() {
+      if (me_) {
+        set_canceled();
+      }
+    }
+
+    void operator()() && noexcept {
+      set_value();
+    }
+
+    void operator()(exception_arg_t, exception_t exception) && noexcept {
+      set_exception(std::move(exception));
+    }
+
+    void set_value() noexcept {
+      resume([](result<>& result) {
+        result.set_value();
+      });
+    }
+
+    void set_exception(exception_t exception) noexcept {
+      resume([&](result<>& result) {
+        result.set_exception(std::move(exception));
+      });
+    }
+
+    void set_canceled() noexcept {
+      resume([](result<>& result) {
+        result.set_canceled();
+      });
+    }
+
+    explicit operator bool() const noexcept {
+      return true;
+    }
+  };
+
+public:
+  explicit resume_on_awaitable(Executor executor)
+    : executor_(std::move(executor)) {}
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(coroutine_handle<> handle) {
+    handle_ = handle;
+
+    // The coroutine could be resumed and destroyed before the executor
+    // returns, hence the executor must not be invoked as part of the frame.
+    Executor executor = std::move(executor_);
+    executor(resume_work(this));
+  }
+
+  void await_resume() noexcept(false) {
+    unpack_await_result(std::move(result_));
+  }
+};
+
 /// This makes it possible to take the coroutine_handle over on suspension
 struct handle_takeover {
   coroutine_handle<>& handle_;
@@ -194,44 +555,171 @@ struct handle_takeover {
   void await_resume() noexcept {}
 };
 
-/// The type which is passed to the compiler that describes the properties
-/// of a continuable_base used as coroutine promise type.
-template <typename Continuable, typename Promise, typename... Args>
-struct promise_type;
-
-/// Implements the resolving method return_void and return_value accordingly
-template <typename Base>
-struct promise_resolver_base;
-
-template <typename Continuable, typename Promise>
-struct promise_resolver_base<promise_type<Continuable, Promise>> {
+/// Implements the resolving method return_void and return_value accordingly,
+/// which store the returned values inside the result_ of the Derived promise.
+template <typename Derived, typename... Args>
+struct promise_resolver_base {
+  template <typename T>
+  void return_value(T&& tuple_like) {
+    auto me = static_cast<Derived*>(this);
+    traits::unpack(
+        [me](auto&&... args) {
+          me->result_.set_value(std::forward<decltype(args)>(args)...);
+        },
+        std::forward<T>(tuple_like));
+  }
+};
+template <typename Derived>
+struct promise_resolver_base<Derived> {
   void return_void() {
-    auto me = static_cast<promise_type<Continuable, Promise>*>(this);
-    me->promise_.set_value();
+    auto me = static_cast<Derived*>(this);
+    me->result_.set_value();
   }
 };
-template <typename Continuable, typename Promise, typename T>
-struct promise_resolver_base<promise_type<Continuable, Promise, T>> {
+template <typename Derived, typename T>
+struct promise_resolver_base<Derived, T> {
   void return_value(T value) {
-    auto me = static_cast<promise_type<Continuable, Promise, T>*>(this);
-    me->promise_.set_value(std::move(value));
+    auto me = static_cast<Derived*>(this);
+    me->result_.set_value(std::move(value));
   }
 };
-template <typename Continuable, typename Promise, typename... Args>
-struct promise_resolver_base<promise_type<Continuable, Promise, Args...>> {
-  template <typename T>
-  void return_value(T&& tuple_like) {
-    auto me = static_cast<promise_type<Continuable, Promise, Args...>*>(this);
-    traits::unpack(std::move(me->promise_), std::forward<T>(tuple_like));
+
+/// Allocates the coroutine frames of a promise from the frame pool of
+/// the current thread.
+struct pooled_frame_base {
+  static void* operator new(std::size_t size) {
+    return allocate_frame(size);
+  }
+  static void operator delete(void* frame, std::size_t size) noexcept {
+    deallocate_frame(frame, size);
+  }
+};
+
+/// Allocates the coroutine frames through the allocator which is passed
+/// after a std::allocator_arg_t tag as first argument of the coroutine,
+/// or after the object when the coroutine is a member function.
+///
+/// The allocation functions are non-template members of a class template
+/// which is selected from the arguments of the coroutine through
+/// frame_base_of, since GCC pairs the usual operator delete only with
+/// non-template allocation functions (-Wmismatched-new-delete).
+template <typename Object, typename Allocator, typename... FunctionArgs>
+struct allocator_frame_base {
+  static void* operator new(std::size_t size) {
+    return allocate_frame(size);
+  }
+  static void* operator new(std::size_t size, Object const&,
+                            std::allocator_arg_t, Allocator const& allocator,
+                            FunctionArgs const&...) {
+    return allocate_frame(size, allocator);
+  }
+  static void operator delete(void* frame, std::size_t size) noexcept {
+    deallocate_frame(frame, size);
+  }
+};
+/// Allocates the coroutine frames of free functions through the allocator
+/// which is passed after a std::allocator_arg_t tag as first argument.
+template <typename Allocator, typename... FunctionArgs>
+struct allocator_frame_base<void, Allocator, FunctionArgs...> {
+  static void* operator new(std::size_t size) {
+    return allocate_frame(size);
+  }
+  static void* operator new(std::size_t size, std::allocator_arg_t,
+                            Allocator const& allocator,
+                            FunctionArgs const&...) {
+    return allocate_frame(size, allocator);
+  }
+  static void operator delete(void* frame, std::size_t size) noexcept {
+    deallocate_frame(frame, size);
+  }
+};
+
+template <typename... FunctionArgs>
+struct frame_base_of_impl {
+  using type = pooled_frame_base;
+};
+template <typename Allocator, typename... FunctionArgs>
+struct frame_base_of_impl<std::allocator_arg_t, Allocator, FunctionArgs...> {
+  using type = allocator_frame_base<void, Allocator, FunctionArgs...>;
+};
+template <typename Object, typename Allocator, typename... FunctionArgs>
+struct frame_base_of_impl<Object, std::allocator_arg_t, Allocator,
+                          FunctionArgs...> {
+  using type = allocator_frame_base<Object, Allocator, FunctionArgs...>;
+};
+
+/// Returns the base class of a promise which allocates the coroutine frame,
+/// for a coroutine with the given argument types.
+template <typename... FunctionArgs>
+using frame_base_of =
+    typename frame_base_of_impl<std::decay_t<FunctionArgs>...>::type;
+
+/// Stores the exception which leaves the coroutine body inside
+/// the result_ of the Derived promise.
+template <typename Derived>
+struct promise_exception_base {
+  void unhandled_exception() noexcept {
+    auto me = static_cast<Derived*>(this);
+#  if defined(CONTINUABLE_HAS_EXCEPTIONS)
+    try {
+      std::rethrow_exception(std::current_exception());
+    } catch (await_canceled_exception const&) {
+      me->result_.set_canceled();
+    } catch (...) {
+      me->result_.set_exception(std::current_exception());
+    }
+#  else  // CONTINUABLE_HAS_EXCEPTIONS
+    (void)me;
+    // Returning exception types from a coroutine isn't supported
+    CTI_DETAIL_TRAP();
+#  endif // CONTINUABLE_HAS_EXCEPTIONS
+  }
+};
+
+/// Resolves the promise of a finished coroutine after its frame was
+/// destroyed, and transfers the control directly to the coroutine which
+/// is resumed by this first, such that deep chains of coroutines which
+/// are resolved on the same thread are running in constant stack space.
+struct final_awaiter {
+  bool await_ready() noexcept {
+    return false;
+  }
+
+  template <typename PromiseType>
+  coroutine_handle<>
+  await_suspend(coroutine_handle<PromiseType> handle) noexcept {
+    auto promise = std::move(handle.promise().promise_);
+    auto result = std::move(handle.promise().result_);
+    handle.destroy();
+
+    resumption_scope scope;
+    if (result.is_value()) {
+      traits::unpack(std::move(promise), std::move(result));
+    } else if (result.is_exception()) {
+      promise.set_exception(std::move(result).get_exception());
+    } else {
+      promise.set_canceled();
+    }
+    return scope.target();
   }
+
+  void await_resume() noexcept {}
 };
 
-template <typename Continuable, typename Promise, typename... Args>
+/// The type which is passed to the compiler that describes the properties
+/// of a continuable_base used as coroutine promise type.
+template <typename Continuable, typename Promise, typename FrameBase,
+          typename... Args>
 struct promise_type
-  : promise_resolver_base<promise_type<Continuable, Promise, Args...>> {
+  : promise_resolver_base<promise_type<Continuable, Promise, FrameBase, Args...>,
+                          Args...>,
+    promise_exception_base<
+        promise_type<Continuable, Promise, FrameBase, Args...>>,
+    FrameBase {
 
   coroutine_handle<> handle_;
   Promise promise_;
+  result<Args...> result_;
 
   explicit promise_type() = default;
 
@@ -246,24 +734,9 @@ struct promise_type
     return {handle_};
   }
 
-  suspend_never final_suspend() noexcept {
+  final_awaiter final_suspend() noexcept {
     return {};
   }
-
-  void unhandled_exception() noexcept {
-#  if defined(CONTINUABLE_HAS_EXCEPTIONS)
-    try {
-      std::rethrow_exception(std::current_exception());
-    } catch (await_canceled_exception const&) {
-      promise_.set_canceled();
-    } catch (...) {
-      promise_.set_exception(std::current_exception());
-    }
-#  else  // CONTINUABLE_HAS_EXCEPTIONS
-    // Returning exception types from a coroutine isn't supported
-    CTI_DETAIL_TRAP();
-#  endif // CONTINUABLE_HAS_EXCEPTIONS
-  }
 };
 } // namespace awaiting
 } // namespace detail
@@ -31,21 +31,62 @@
 #ifndef CONTINUABLE_DETAIL_ERASURE_HPP_INCLUDED
 #define CONTINUABLE_DETAIL_ERASURE_HPP_INCLUDED
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 #include <function2/function2.hpp>
 #include <continuable/detail/core/base.hpp>
+#include <continuable/detail/core/types.hpp>
 #include <continuable/detail/features.hpp>
 #include <continuable/detail/utility/traits.hpp>
 
 namespace cti {
 namespace detail {
 namespace erasure {
+/// Deduces to a true_type if the given type T is stored inside the inplace
+/// storage of a type erasure with the given Capacity,
+/// otherwise T is allocated on the heap.
+///
+/// This mirrors the condition that function2 uses to decide whether an
+/// object is constructed in place.
+template <typename T, typename Capacity>
+struct is_inplace_storable
+    : std::integral_constant<bool,
+                             (sizeof(T) <= Capacity::capacity) &&
+                                 (alignof(T) <= Capacity::alignment) &&
+                                 std::is_nothrow_move_constructible<T>::value> {
+};
+
+/// The capacity of the callback type erasure which is large enough to store
+/// the proxy callbacks created through base::callbacks::make_callback
+/// without allocating, as long as the callable object captures not more
+/// than a few pointers and its result is forwarded to a callback of
+/// similar size.
+struct callback_capacity {
+  using type = union {
+    void* pointer_;
+    struct {
+      void* callback_[2];
+      types::this_thread_executor_tag executor_;
+      void* next_callback_[2];
+    } proxy_;
+  };
+
+  static constexpr std::size_t capacity = sizeof(type);
+  static constexpr std::size_t alignment = alignof(type);
+};
+
 template <typename... Args>
 using callback_erasure_t =
-    fu2::function_base<true, false, fu2::capacity_none, true, false,
+    fu2::function_base<true, false, callback_capacity, true, false,
                        void(Args...)&&, void(exception_arg_t, exception_t) &&>;
 
+/// Deduces to a true_type if the given callable object is stored in place
+/// when it is converted to a type erased callback.
+template <typename T>
+struct is_inplace_callback
+    : is_inplace_storable<traits::unrefcv_t<T>, callback_capacity> {};
+
 #ifdef CONTINUABLE_HAS_IMMEDIATE_TYPES
 template <typename... Args>
 using callback = callback_erasure_t<Args...>;
@@ -234,6 +275,154 @@ public:
   }
 };
 #endif
+
+/// A type erased callback which allocates callable objects that don't fit
+/// into the inplace capacity through the given Allocator.
+template <typename Allocator, typename... Args>
+class basic_callback {
+  using erasure_t = callback_erasure_t<Args...>;
+  erasure_t erasure_;
+
+public:
+  basic_callback() = default;
+  ~basic_callback() = default;
+  basic_callback(basic_callback const&) = delete;
+  basic_callback(basic_callback&&) = default;
+  basic_callback& operator=(basic_callback const&) = delete;
+  basic_callback& operator=(basic_callback&&) = default;
+
+  template <typename T,
+            std::enable_if_t<std::is_convertible<T, erasure_t>::value>* =
+                nullptr,
+            std::enable_if_t<!std::is_same<traits::unrefcv_t<T>,
+                                           basic_callback>::value>* = nullptr>
+  /* implicit */ basic_callback(T&& callable,
+                                Allocator const& allocator = Allocator())
+      : erasure_(std::forward<T>(callable), allocator) {
+  }
+
+  basic_callback& operator=(std::nullptr_t) noexcept {
+    erasure_ = nullptr;
+    return *this;
+  }
+
+  void operator()(Args... args) && noexcept {
+    std::move(erasure_)(std::move(args)...);
+  }
+
+  void operator()(exception_arg_t exception_arg, exception_t exception) &&
+      noexcept {
+    std::move(erasure_)(exception_arg, std::move(exception));
+  }
+
+  explicit operator bool() const noexcept {
+    return bool(erasure_);
+  }
+};
+
+/// A type erased work which allocates callable objects that don't fit
+/// into the inplace capacity through the given Allocator.
+template <typename Allocator>
+class basic_work {
+  using erasure_t = work_erasure_t;
+  erasure_t erasure_;
+
+public:
+  basic_work() = default;
+  ~basic_work() = default;
+  basic_work(basic_work const&) = delete;
+  basic_work(basic_work&&) = default;
+  basic_work& operator=(basic_work const&) = delete;
+  basic_work& operator=(basic_work&&) = default;
+
+  template <typename T,
+            std::enable_if_t<std::is_convertible<T, erasure_t>::value>* =
+                nullptr,
+            std::enable_if_t<
+                !std::is_same<traits::unrefcv_t<T>, basic_work>::value>* =
+                nullptr>
+  /* implicit */ basic_work(T&& callable,
+                            Allocator const& allocator = Allocator())
+      : erasure_(std::forward<T>(callable), allocator) {
+  }
+
+  basic_work& operator=(std::nullptr_t) noexcept {
+    erasure_ = nullptr;
+    return *this;
+  }
+
+  void operator()() && noexcept {
+    std::move(erasure_)();
+  }
+
+  void operator()(exception_arg_t, exception_t exception) && noexcept {
+    std::move(erasure_)(exception_arg_t{}, std::move(exception));
+  }
+
+  explicit operator bool() const noexcept {
+    return bool(erasure_);
+  }
+};
+
+/// A type erased continuation which allocates callable objects that don't
+/// fit into the inplace capacity through the given Allocator.
+///
+/// The allocator is propagated to the basic_callback objects that are created
+/// when the continuation is invoked, such that all allocations of an
+/// asynchronous call chain are served by the same allocator.
+template <typename Allocator, typename... Args>
+class basic_continuation {
+  using promise_t = promise_base<basic_callback<Allocator, Args...>, //
+                                 signature_arg_t<Args...>>;
+  using erasure_t = fu2::function_base<
+      true, false, continuation_capacity<Args...>, true, false, void(promise_t),
+      bool(is_ready_arg_t) const, result<Args...>(unpack_arg_t)>;
+
+  erasure_t erasure_;
+  Allocator allocator_;
+
+public:
+  basic_continuation() = default;
+  ~basic_continuation() = default;
+  basic_continuation(basic_continuation const&) = delete;
+  basic_continuation(basic_continuation&&) = default;
+  basic_continuation& operator=(basic_continuation const&) = delete;
+  basic_continuation& operator=(basic_continuation&&) = default;
+
+  template <typename T,
+            std::enable_if_t<std::is_convertible<T, erasure_t>::value>* =
+                nullptr,
+            std::enable_if_t<!std::is_same<traits::unrefcv_t<T>,
+                                           basic_continuation>::value>* =
+                nullptr>
+  /* implicit */ basic_continuation(T&& callable,
+                                    Allocator const& allocator = Allocator())
+      : erasure_(std::forward<T>(callable), allocator), allocator_(allocator) {
+  }
+
+  void operator()(promise_t promise) {
+    erasure_(std::move(promise));
+  }
+
+  template <typename Callback,
+            std::enable_if_t<std::is_convertible<
+                Callback, basic_callback<Allocator, Args...>>::value>* =
+                nullptr,
+            std::enable_if_t<!std::is_same<traits::unrefcv_t<Callback>,
+                                           promise_t>::value>* = nullptr>
+  void operator()(Callback&& callback) {
+    erasure_(promise_t(basic_callback<Allocator, Args...>(
+        std::forward<Callback>(callback), allocator_)));
+  }
+
+  bool operator()(is_ready_arg_t is_ready_arg) const {
+    return erasure_(is_ready_arg);
+  }
+
+  result<Args...> operator()(unpack_arg_t query_arg) {
+    return erasure_(query_arg);
+  }
+};
 } // namespace erasure
 } // namespace detail
 } // namespace cti
@@ -0,0 +1,229 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_FRAME_POOL_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_FRAME_POOL_HPP_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace cti {
+namespace detail {
+namespace awaiting {
+/// The granularity of the size classes of the frame pool
+constexpr std::size_t frame_granularity = 64U;
+/// The count of size classes, frames larger than
+/// frame_classes * frame_granularity (1 KiB) are allocated on the heap.
+constexpr std::size_t frame_classes = 16U;
+/// The count of frames which are kept per size class and thread
+constexpr std::size_t frame_cache_limit = 64U;
+
+/// A thread-local cache of coroutine frames, which are binned into
+/// size classes, such that a thread which repeatedly creates coroutines
+/// of a similar size reaches a steady state without any heap allocation.
+///
+/// The cache is trivially destructible, such that it can be still accessed
+/// safely from thread-local destructors which release coroutine frames
+/// after the cache was drained.
+class frame_cache {
+  struct block {
+    block* next;
+  };
+
+  block* blocks_[frame_classes];
+  std::size_t counts_[frame_classes];
+  bool closed_;
+
+  /// Drains the frame_cache of the current thread when the thread exits
+  struct reaper {
+    ~reaper() {
+      frame_cache& cache = frame_cache::local();
+      cache.closed_ = true;
+      for (std::size_t i = 0; i < frame_classes; ++i) {
+        while (block* current = cache.blocks_[i]) {
+          cache.blocks_[i] = current->next;
+          ::operator delete(current);
+        }
+        cache.counts_[i] = 0U;
+      }
+    }
+  };
+
+public:
+  static frame_cache& local() noexcept {
+    static thread_local frame_cache cache;
+    return cache;
+  }
+
+  /// Returns the size class of a frame with the given non-zero size,
+  /// the size class i holds frames of up to (i + 1) * frame_granularity.
+  static constexpr std::size_t size_class_of(std::size_t size) noexcept {
+    return (size - 1U) / frame_granularity;
+  }
+
+  void* allocate(std::size_t size) {
+    std::size_t const size_class = size_class_of(size);
+    if (size_class >= frame_classes) {
+      return ::operator new(size);
+    }
+
+    if (block* current = blocks_[size_class]) {
+      blocks_[size_class] = current->next;
+      --counts_[size_class];
+      return current;
+    }
+    return ::operator new((size_class + 1U) * frame_granularity);
+  }
+
+  void deallocate(void* frame, std::size_t size) noexcept {
+    std::size_t const size_class = size_class_of(size);
+    if ((size_class >= frame_classes) || closed_ ||
+        (counts_[size_class] >= frame_cache_limit)) {
+      ::operator delete(frame);
+      return;
+    }
+
+    // Registers the reaper of the current thread on first use
+    static thread_local reaper drain;
+    (void)drain;
+
+    blocks_[size_class] = ::new (frame) block{blocks_[size_class]};
+    ++counts_[size_class];
+  }
+};
+
+static_assert(std::is_trivially_destructible<frame_cache>::value,
+              "The frame_cache must be accessible during thread shutdown!");
+
+/// The function which is stored behind every frame, that releases it
+using frame_deallocator = void (*)(void* frame, std::size_t size) noexcept;
+
+/// Returns the offset of the frame_deallocator behind a frame of the size
+constexpr std::size_t deallocator_offset(std::size_t size) noexcept {
+  return (size + alignof(frame_deallocator) - 1U) &
+         ~(alignof(frame_deallocator) - 1U);
+}
+
+/// Returns the offset of an allocator which is stored behind the
+/// frame_deallocator of a frame with the given size
+template <typename Allocator>
+constexpr std::size_t allocator_offset(std::size_t size) noexcept {
+  return (deallocator_offset(size) + sizeof(frame_deallocator) +
+          alignof(Allocator) - 1U) &
+         ~(alignof(Allocator) - 1U);
+}
+
+inline frame_deallocator& deallocator_of(void* frame,
+                                         std::size_t size) noexcept {
+  return *static_cast<frame_deallocator*>(static_cast<void*>(
+      static_cast<unsigned char*>(frame) + deallocator_offset(size)));
+}
+
+template <typename Allocator>
+Allocator* allocator_of(void* frame, std::size_t size) noexcept {
+  return static_cast<Allocator*>(static_cast<void*>(
+      static_cast<unsigned char*>(frame) + allocator_offset<Allocator>(size)));
+}
+
+/// The unit in which frames are requested from a user provided allocator,
+/// such that the frames are aligned suitably for any coroutine.
+struct alignas(std::max_align_t) frame_block {
+  unsigned char storage[alignof(std::max_align_t)];
+};
+
+/// Returns the count of frame_block units which hold the given size
+constexpr std::size_t frame_blocks_of(std::size_t size) noexcept {
+  return (size + sizeof(frame_block) - 1U) / sizeof(frame_block);
+}
+
+template <typename Allocator>
+using block_allocator_t =
+    typename std::allocator_traits<Allocator>::template rebind_alloc<
+        frame_block>;
+
+/// Allocates a coroutine frame of the given size from the frame_cache of
+/// the current thread, or from the global heap if
+/// CONTINUABLE_WITH_NO_FRAME_POOL is defined.
+inline void* allocate_frame(std::size_t size) {
+  std::size_t const total = deallocator_offset(size) + sizeof(frame_deallocator);
+#if defined(CONTINUABLE_WITH_NO_FRAME_POOL)
+  void* frame = ::operator new(total);
+  deallocator_of(frame, size) = [](void* frame, std::size_t) noexcept {
+    ::operator delete(frame);
+  };
+#else
+  void* frame = frame_cache::local().allocate(total);
+  deallocator_of(frame, size) = [](void* frame, std::size_t size) noexcept {
+    frame_cache::local().deallocate(frame, deallocator_offset(size) +
+                                               sizeof(frame_deallocator));
+  };
+#endif // CONTINUABLE_WITH_NO_FRAME_POOL
+  return frame;
+}
+
+/// Allocates a coroutine frame of the given size through a copy of the
+/// given allocator, which is stored behind the frame.
+template <typename Allocator>
+void* allocate_frame(std::size_t size, Allocator const& allocator) {
+  using allocator_t = block_allocator_t<Allocator>;
+  using traits_t = std::allocator_traits<allocator_t>;
+
+  std::size_t const total = allocator_offset<allocator_t>(size) +
+                            sizeof(allocator_t);
+
+  allocator_t frame_allocator(allocator);
+  void* frame = traits_t::allocate(frame_allocator, frame_blocks_of(total));
+  ::new (allocator_of<allocator_t>(frame, size))
+      allocator_t(std::move(frame_allocator));
+
+  deallocator_of(frame, size) = [](void* frame, std::size_t size) noexcept {
+    allocator_t* stored = allocator_of<allocator_t>(frame, size);
+    allocator_t frame_allocator(std::move(*stored));
+    stored->~allocator_t();
+
+    traits_t::deallocate(
+        frame_allocator, static_cast<frame_block*>(frame),
+        frame_blocks_of(allocator_offset<allocator_t>(size) +
+                        sizeof(allocator_t)));
+  };
+  return frame;
+}
+
+/// Releases a frame which was allocated through allocate_frame
+inline void deallocate_frame(void* frame, std::size_t size) noexcept {
+  deallocator_of(frame, size)(frame, size);
+}
+} // namespace awaiting
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_FRAME_POOL_HPP_INCLUDED
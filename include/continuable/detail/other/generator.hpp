@@ -0,0 +1,167 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_GENERATOR_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_GENERATOR_HPP_INCLUDED
+
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-coroutine.hpp>
+#include <continuable/continuable-result.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/other/coroutines.hpp>
+#include <continuable/detail/other/task.hpp>
+
+#if defined(CONTINUABLE_HAS_COROUTINE)
+namespace cti {
+namespace detail {
+namespace awaiting {
+/// Suspends the generator on a co_yield expression and transfers
+/// the control to the coroutine which is waiting for the yielded value.
+struct yield_awaiter {
+  bool await_ready() noexcept {
+    return false;
+  }
+
+  template <typename PromiseType>
+  coroutine_handle<>
+  await_suspend(coroutine_handle<PromiseType> handle) noexcept {
+    return handle.promise().continuation_;
+  }
+
+  void await_resume() noexcept {}
+};
+
+/// The part of the promise of a generator which is accessed by its consumer,
+/// which is independent of the arguments of the coroutine.
+template <typename T>
+struct generator_state {
+  coroutine_handle<> continuation_;
+  /// Is empty when the generator has finished
+  result<T> result_;
+};
+
+/// The promise type of an asynchronous generator, which is resumed by
+/// its consumer for every value it requests, and which is suspended
+/// on every yielded value until the consumer requests the next one.
+template <typename Generator, typename FrameBase, typename T>
+struct generator_promise
+  : generator_state<T>,
+    promise_exception_base<generator_promise<Generator, FrameBase, T>>,
+    FrameBase {
+
+  explicit generator_promise() = default;
+
+  Generator get_return_object() noexcept {
+    return Generator(coroutine_handle<generator_promise>::from_promise(*this),
+                     this);
+  }
+
+  suspend_always initial_suspend() noexcept {
+    return {};
+  }
+
+  task_final_awaiter final_suspend() noexcept {
+    return {};
+  }
+
+  yield_awaiter yield_value(T value) {
+    this->result_.set_value(std::move(value));
+    return {};
+  }
+
+  void return_void() noexcept {}
+};
+
+/// Resumes the generator until it yields its next value or finishes,
+/// and resumes the consuming coroutine with the result of it.
+template <typename T>
+class next_awaitable {
+  coroutine_handle<> handle_;
+  generator_state<T>* state_;
+
+public:
+  explicit next_awaitable(coroutine_handle<> handle,
+                          generator_state<T>* state) noexcept
+    : handle_(handle), state_(state) {
+    assert(handle_ && "Tried to await an invalid generator!");
+  }
+
+  bool await_ready() const noexcept {
+    return handle_.done();
+  }
+
+  coroutine_handle<> await_suspend(coroutine_handle<> handle) noexcept {
+    state_->continuation_ = handle;
+    return handle_;
+  }
+
+  auto await_resume() noexcept {
+    auto current = std::move(state_->result_);
+    state_->result_.set_empty();
+    return current;
+  }
+};
+
+/// Invokes the given callable and awaits the continuable it returns,
+/// which makes it possible to pull the next value after the previous
+/// one was consumed asynchronously.
+template <typename Callable, typename T>
+auto consume_value(Callable& callable, T&& value) {
+  using result_t = decltype(callable(std::forward<T>(value)));
+  if constexpr (base::is_continuable<std::decay_t<result_t>>::value) {
+    return callable(std::forward<T>(value));
+  } else {
+    callable(std::forward<T>(value));
+    return suspend_never{};
+  }
+}
+
+/// Pulls all values out of the generator and passes those to the callable
+template <typename Continuable, typename Generator, typename Callable>
+Continuable for_each(Generator generator, Callable callable) {
+  for (;;) {
+    auto current = co_await generator.next();
+    if (current.is_empty()) {
+      co_return;
+    }
+
+    // Rethrows the exception the generator failed with
+    co_await consume_value(callable, unpack_await_result(std::move(current)));
+  }
+}
+} // namespace awaiting
+} // namespace detail
+} // namespace cti
+#endif // defined(CONTINUABLE_HAS_COROUTINE)
+
+#endif // CONTINUABLE_DETAIL_GENERATOR_HPP_INCLUDED
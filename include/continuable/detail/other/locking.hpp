@@ -0,0 +1,564 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_LOCKING_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_LOCKING_HPP_INCLUDED
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <continuable/continuable-primitives.hpp>
+#include <continuable/detail/utility/intrusive-queue.hpp>
+#include <continuable/detail/utility/traits.hpp>
+
+namespace cti {
+namespace detail {
+namespace locking {
+/// Releases an exclusive ownership of a Lockable
+struct unlock_exclusive {
+  template <typename Lockable>
+  static void release(Lockable& lockable) {
+    lockable.unlock();
+  }
+};
+/// Releases a shared ownership of a Lockable
+struct unlock_shared {
+  template <typename Lockable>
+  static void release(Lockable& lockable) {
+    lockable.unlock_shared();
+  }
+};
+/// Releases a count of a semaphore
+struct release_count {
+  template <typename Lockable>
+  static void release(Lockable& lockable) {
+    lockable.release();
+  }
+};
+
+/// A move-only guard which owns a Lockable until it is destroyed,
+/// the ownership is released through the given Release policy.
+template <typename Lockable, typename Release>
+class basic_guard {
+  Lockable* lockable_ = nullptr;
+
+public:
+  basic_guard() = default;
+  basic_guard(Lockable& lockable, std::adopt_lock_t) noexcept
+      : lockable_(&lockable) {
+  }
+  ~basic_guard() {
+    unlock();
+  }
+
+  basic_guard(basic_guard const&) = delete;
+  basic_guard(basic_guard&& other) noexcept
+      : lockable_(std::exchange(other.lockable_, nullptr)) {
+  }
+  basic_guard& operator=(basic_guard const&) = delete;
+  basic_guard& operator=(basic_guard&& other) noexcept {
+    if (this != &other) {
+      unlock();
+      lockable_ = std::exchange(other.lockable_, nullptr);
+    }
+    return *this;
+  }
+
+  /// Returns true when the guard owns the Lockable
+  bool owns_lock() const noexcept {
+    return lockable_ != nullptr;
+  }
+  /// \copydoc owns_lock
+  explicit operator bool() const noexcept {
+    return owns_lock();
+  }
+
+  /// Releases the ownership of the Lockable before the guard is destroyed
+  void unlock() {
+    if (Lockable* lockable = std::exchange(lockable_, nullptr)) {
+      Release::release(*lockable);
+    }
+  }
+
+  /// Disassociates the guard from the Lockable without releasing
+  /// its ownership, which is passed to the caller.
+  Lockable* release() noexcept {
+    return std::exchange(lockable_, nullptr);
+  }
+};
+
+/// A continuation which waits for the ownership of a lock
+class lock_waiter {
+public:
+  lock_waiter* next = nullptr;
+  /// Is false for waiters which acquire a shared ownership
+  bool exclusive = true;
+
+  lock_waiter() = default;
+  virtual ~lock_waiter() = default;
+
+  lock_waiter(lock_waiter const&) = delete;
+  lock_waiter& operator=(lock_waiter const&) = delete;
+
+  /// Is called when the ownership was passed to the waiter
+  virtual void resolve() = 0;
+  /// Is called when the lock was destroyed
+  virtual void cancel() = 0;
+};
+
+/// Resolves the callback with a Guard which adopts the ownership
+/// of the given Lockable.
+template <typename Callback, typename Guard, typename Lockable>
+class lock_waiter_of final : public lock_waiter {
+  Callback callback_;
+  Lockable* lockable_;
+
+public:
+  explicit lock_waiter_of(Callback callback, Lockable* lockable,
+                          bool exclusive_ = true)
+      : callback_(std::move(callback)), lockable_(lockable) {
+    exclusive = exclusive_;
+  }
+
+  void resolve() override {
+    std::move(callback_)(Guard(*lockable_, std::adopt_lock));
+  }
+
+  void cancel() override {
+    std::move(callback_)(exception_arg_t{}, exception_t{});
+  }
+};
+
+/// Queues a waiter which resolves the callback with a Guard through the
+/// given enqueue function, the waiter is resolved immediately when
+/// the enqueue function acquired the ownership instead.
+template <typename Guard, typename Lockable, typename Callback,
+          typename Enqueue>
+void acquire_or_park(Lockable& lockable, Callback&& callback, bool exclusive,
+                     Enqueue&& enqueue) {
+  using waiter_t =
+      lock_waiter_of<traits::unrefcv_t<Callback>, Guard, Lockable>;
+
+  std::unique_ptr<lock_waiter> waiter(
+      new waiter_t(std::forward<Callback>(callback), &lockable, exclusive));
+  if (std::forward<Enqueue>(enqueue)(waiter.get())) {
+    waiter->resolve();
+  } else {
+    waiter.release();
+  }
+}
+
+/// Resolves the waiters which were handed the ownership of a lock on the
+/// current thread.
+///
+/// A waiter which releases its guard synchronously hands the ownership
+/// of the same lock to the next waiter from inside of its own resolution.
+/// Such waiters are queued and resolved after the resolution of the current
+/// waiter returned, such that a long queue of synchronous waiters doesn't
+/// recurse once per waiter. Handoffs of other locks are resolved inline,
+/// hence the nesting is bounded by the count of distinct locks.
+class handoff_trampoline {
+  /// The resolution of the waiters of a lock on the current thread
+  struct frame {
+    void const* lock;
+    frame* parent;
+    util::intrusive_queue<lock_waiter> pending;
+  };
+
+  static frame*& current() noexcept {
+    static thread_local frame* top = nullptr;
+    return top;
+  }
+
+public:
+  /// Resolves and deletes the given waiter of the given lock
+  static void resolve(void const* lock, lock_waiter* waiter) {
+    util::intrusive_queue<lock_waiter> waiters;
+    waiters.push_back(waiter);
+    resolve_all(lock, waiters);
+  }
+
+  /// Resolves and deletes all waiters of the given queue and lock
+  static void resolve_all(void const* lock,
+                          util::intrusive_queue<lock_waiter>& waiters) {
+    for (frame* active = current(); active; active = active->parent) {
+      if (active->lock == lock) {
+        while (lock_waiter* waiter = waiters.pop_front()) {
+          active->pending.push_back(waiter);
+        }
+        return;
+      }
+    }
+
+    frame resolution{lock, current(), {}};
+    while (lock_waiter* waiter = waiters.pop_front()) {
+      resolution.pending.push_back(waiter);
+    }
+
+    struct resetter {
+      frame* resolution;
+      ~resetter() {
+        current() = resolution->parent;
+      }
+    } reset{&resolution};
+    current() = &resolution;
+
+    while (lock_waiter* waiter = resolution.pending.pop_front()) {
+      std::unique_ptr<lock_waiter> owned(waiter);
+      owned->resolve();
+    }
+  }
+};
+
+/// Cancels and deletes all waiters of the given queue
+inline void cancel_all(util::intrusive_queue<lock_waiter>& waiters) {
+  while (lock_waiter* waiter = waiters.pop_front()) {
+    waiter->cancel();
+    delete waiter;
+  }
+}
+
+/// The state of an asynchronous mutex which doesn't require any lock.
+///
+/// The state word is either not_locked, locked_no_waiters or a pointer
+/// to the waiter which was queued last. Waiters are pushed onto this
+/// stack through a compare and swap, the owner of the mutex takes the stack
+/// over in reverse order when it unlocks the mutex and doesn't find
+/// a previously taken over waiter, such that waiters are resumed in
+/// the order they were queued.
+class mutex_state {
+  static constexpr std::uintptr_t not_locked = 1U;
+  static constexpr std::uintptr_t locked_no_waiters = 0U;
+
+  std::atomic<std::uintptr_t> state_{not_locked};
+  /// The waiters which were taken over by the owner, in the order
+  /// they are resumed. Is only accessed by the owner of the mutex.
+  lock_waiter* waiters_ = nullptr;
+
+public:
+  mutex_state() = default;
+  ~mutex_state() {
+    util::intrusive_queue<lock_waiter> waiters;
+    take_over(waiters, waiters_);
+    take_over(waiters, reversed(state_.load(std::memory_order_relaxed)));
+    cancel_all(waiters);
+  }
+
+  mutex_state(mutex_state const&) = delete;
+  mutex_state& operator=(mutex_state const&) = delete;
+
+  bool try_lock() noexcept {
+    std::uintptr_t expected = not_locked;
+    return state_.compare_exchange_strong(expected, locked_no_waiters,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed);
+  }
+
+  /// Acquires the mutex and returns true, or queues the waiter and returns
+  /// false when the mutex is locked already.
+  bool lock_or_enqueue(lock_waiter* waiter) noexcept {
+    std::uintptr_t current = state_.load(std::memory_order_acquire);
+    for (;;) {
+      if (current == not_locked) {
+        if (state_.compare_exchange_weak(current, locked_no_waiters,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed)) {
+          return true;
+        }
+      } else {
+        waiter->next = reinterpret_cast<lock_waiter*>(current);
+        if (state_.compare_exchange_weak(
+                current, reinterpret_cast<std::uintptr_t>(waiter),
+                std::memory_order_release, std::memory_order_relaxed)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  /// Unlocks the mutex, or returns the waiter which the ownership
+  /// was passed to.
+  lock_waiter* unlock() noexcept {
+    assert((state_.load(std::memory_order_relaxed) != not_locked) &&
+           "The mutex was unlocked while it isn't locked!");
+
+    lock_waiter* head = waiters_;
+    if (!head) {
+      std::uintptr_t expected = locked_no_waiters;
+      if (state_.compare_exchange_strong(expected, not_locked,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+        return nullptr;
+      }
+
+      // Take the stack of waiters over which were queued meanwhile
+      head = reversed(
+          state_.exchange(locked_no_waiters, std::memory_order_acquire));
+      assert(head);
+    }
+
+    waiters_ = head->next;
+    return head;
+  }
+
+private:
+  /// Reverses the stack which is stored in the given state word
+  static lock_waiter* reversed(std::uintptr_t stack) noexcept {
+    if ((stack == not_locked) || (stack == locked_no_waiters)) {
+      return nullptr;
+    }
+
+    lock_waiter* current = reinterpret_cast<lock_waiter*>(stack);
+    lock_waiter* previous = nullptr;
+    while (current) {
+      previous = std::exchange(current, std::exchange(current->next, previous));
+    }
+    return previous;
+  }
+
+  static void take_over(util::intrusive_queue<lock_waiter>& waiters,
+                        lock_waiter* list) noexcept {
+    while (list) {
+      waiters.push_back(std::exchange(list, list->next));
+    }
+  }
+};
+
+/// The state of an asynchronous counting semaphore.
+///
+/// The count is decremented by every acquisition and becomes negative
+/// by the count of waiters, hence an uncontended acquisition or release
+/// only modifies the count. The queue of waiters is guarded by a lock which
+/// is held for queueing or dequeuing a single waiter only.
+/// A release which finds a negative count before the corresponding waiter
+/// was queued leaves a token, which is taken by the waiter instead of
+/// queueing itself.
+class semaphore_state {
+  std::atomic<std::ptrdiff_t> count_;
+  std::mutex lock_;
+  std::size_t tokens_ = 0U;
+  util::intrusive_queue<lock_waiter> waiters_;
+
+public:
+  explicit semaphore_state(std::ptrdiff_t count) : count_(count) {
+    assert(count >= 0);
+  }
+  ~semaphore_state() {
+    cancel_all(waiters_);
+  }
+
+  semaphore_state(semaphore_state const&) = delete;
+  semaphore_state& operator=(semaphore_state const&) = delete;
+
+  bool try_acquire() noexcept {
+    std::ptrdiff_t current = count_.load(std::memory_order_relaxed);
+    while (current > 0) {
+      if (count_.compare_exchange_weak(current, current - 1,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Acquires the semaphore and returns true, or queues the waiter
+  /// and returns false when no count is available.
+  bool acquire_or_enqueue(lock_waiter* waiter) {
+    if (count_.fetch_sub(1, std::memory_order_acquire) > 0) {
+      return true;
+    }
+
+    std::lock_guard<std::mutex> lock(lock_);
+    if (tokens_ > 0U) {
+      --tokens_;
+      return true;
+    }
+    waiters_.push_back(waiter);
+    return false;
+  }
+
+  /// Releases a count, or returns the waiter which the count
+  /// was passed to.
+  lock_waiter* release() {
+    if (count_.fetch_add(1, std::memory_order_release) >= 0) {
+      return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(lock_);
+    if (lock_waiter* waiter = waiters_.pop_front()) {
+      return waiter;
+    }
+    ++tokens_;
+    return nullptr;
+  }
+};
+
+/// The state of an asynchronous reader-writer lock.
+///
+/// The state word stores the count of shared owners, the exclusive owner and
+/// whether waiters are queued. Uncontended acquisitions and releases only
+/// modify the word, while queued waiters force all acquisitions through
+/// the queue which is guarded by a lock, hence waiters are resumed in
+/// the order they were queued. A queued exclusive waiter blocks all shared
+/// acquisitions which arrive after it.
+class shared_mutex_state {
+  static constexpr std::size_t exclusive_bit = 1U;
+  static constexpr std::size_t waiting_bit = 2U;
+  static constexpr std::size_t shared_unit = 4U;
+
+  std::atomic<std::size_t> state_{0U};
+  std::mutex lock_;
+  util::intrusive_queue<lock_waiter> waiters_;
+
+public:
+  shared_mutex_state() = default;
+  ~shared_mutex_state() {
+    cancel_all(waiters_);
+  }
+
+  shared_mutex_state(shared_mutex_state const&) = delete;
+  shared_mutex_state& operator=(shared_mutex_state const&) = delete;
+
+  bool try_lock() noexcept {
+    std::size_t expected = 0U;
+    return state_.compare_exchange_strong(expected, exclusive_bit,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed);
+  }
+
+  bool try_lock_shared() noexcept {
+    std::size_t current = state_.load(std::memory_order_relaxed);
+    while (!(current & (exclusive_bit | waiting_bit))) {
+      if (state_.compare_exchange_weak(current, current + shared_unit,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Acquires the lock and returns true, or queues the waiter and returns
+  /// false when the lock can't be acquired in the requested mode.
+  bool lock_or_enqueue(lock_waiter* waiter) {
+    std::lock_guard<std::mutex> lock(lock_);
+    std::size_t current = state_.load(std::memory_order_relaxed);
+    for (;;) {
+      if (waiters_.empty() && is_acquirable(current, waiter->exclusive)) {
+        if (state_.compare_exchange_weak(current, acquired(current, *waiter),
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed)) {
+          return true;
+        }
+      } else if (state_.compare_exchange_weak(current, current | waiting_bit,
+                                              std::memory_order_relaxed)) {
+        waiters_.push_back(waiter);
+        return false;
+      }
+    }
+  }
+
+  /// Releases the exclusive ownership, and moves the waiters which
+  /// acquired the lock meanwhile into the given queue.
+  void unlock(util::intrusive_queue<lock_waiter>& acquired_waiters) {
+    std::size_t expected = exclusive_bit;
+    if (state_.compare_exchange_strong(expected, 0U,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(lock_);
+    state_.fetch_and(~exclusive_bit, std::memory_order_release);
+    grant(acquired_waiters);
+  }
+
+  /// Releases a shared ownership, and moves the waiters which
+  /// acquired the lock meanwhile into the given queue.
+  void unlock_shared(util::intrusive_queue<lock_waiter>& acquired_waiters) {
+    std::size_t const previous =
+        state_.fetch_sub(shared_unit, std::memory_order_release);
+    assert(previous >= shared_unit);
+
+    if ((previous >= 2U * shared_unit) || !(previous & waiting_bit)) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(lock_);
+    grant(acquired_waiters);
+  }
+
+private:
+  static bool is_acquirable(std::size_t current, bool exclusive) noexcept {
+    if (exclusive) {
+      return (current & ~waiting_bit) == 0U;
+    }
+    return !(current & exclusive_bit);
+  }
+
+  static std::size_t acquired(std::size_t current,
+                              lock_waiter const& waiter) noexcept {
+    return waiter.exclusive ? (current | exclusive_bit)
+                            : (current + shared_unit);
+  }
+
+  /// Passes the ownership to the waiters at the front of the queue, which
+  /// can acquire the lock in the order they were queued.
+  void grant(util::intrusive_queue<lock_waiter>& acquired_waiters) {
+    std::size_t current = state_.load(std::memory_order_relaxed);
+    while (lock_waiter* waiter = waiters_.front()) {
+      if (!is_acquirable(current, waiter->exclusive)) {
+        break;
+      }
+
+      std::size_t next = acquired(current, *waiter);
+      if (waiters_.front()->next == nullptr) {
+        next &= ~waiting_bit;
+      }
+
+      if (state_.compare_exchange_weak(current, next,
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_relaxed)) {
+        acquired_waiters.push_back(waiters_.pop_front());
+        current = next;
+      }
+    }
+  }
+};
+} // namespace locking
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_LOCKING_HPP_INCLUDED
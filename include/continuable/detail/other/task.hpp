@@ -0,0 +1,145 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_TASK_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_TASK_HPP_INCLUDED
+
+#include <cassert>
+#include <utility>
+#include <continuable/continuable-coroutine.hpp>
+#include <continuable/continuable-result.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/other/coroutines.hpp>
+
+#if defined(CONTINUABLE_HAS_COROUTINE)
+namespace cti {
+namespace detail {
+namespace awaiting {
+/// Transfers the control to the coroutine which awaits the finished task,
+/// the frame of the task is destroyed by its awaiter after it was resumed.
+struct task_final_awaiter {
+  bool await_ready() noexcept {
+    return false;
+  }
+
+  template <typename PromiseType>
+  coroutine_handle<>
+  await_suspend(coroutine_handle<PromiseType> handle) noexcept {
+    assert(handle.promise().continuation_ &&
+           "A task was resumed without being awaited!");
+    return handle.promise().continuation_;
+  }
+
+  void await_resume() noexcept {}
+};
+
+/// The part of the promise of a task which is accessed by its awaiter,
+/// which is independent of the arguments of the coroutine.
+template <typename... Args>
+struct task_state {
+  coroutine_handle<> continuation_;
+  result<Args...> result_;
+};
+
+/// The promise type of a lazy task, which is started when it is awaited and
+/// resumes its awaiter directly through its coroutine handle.
+template <typename Task, typename FrameBase, typename... Args>
+struct task_promise
+  : task_state<Args...>,
+    promise_resolver_base<task_promise<Task, FrameBase, Args...>, Args...>,
+    promise_exception_base<task_promise<Task, FrameBase, Args...>>,
+    FrameBase {
+
+  explicit task_promise() = default;
+
+  Task get_return_object() noexcept {
+    return Task(coroutine_handle<task_promise>::from_promise(*this), this);
+  }
+
+  suspend_always initial_suspend() noexcept {
+    return {};
+  }
+
+  task_final_awaiter final_suspend() noexcept {
+    return {};
+  }
+};
+
+/// Starts the task on suspension of the awaiting coroutine, and takes
+/// the ownership over the frame of the task.
+template <typename... Args>
+class task_awaitable {
+  coroutine_handle<> handle_;
+  task_state<Args...>* state_;
+
+public:
+  explicit task_awaitable(coroutine_handle<> handle,
+                          task_state<Args...>* state) noexcept
+    : handle_(handle), state_(state) {
+    assert(handle_ && "Tried to await an invalid task!");
+  }
+  ~task_awaitable() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  task_awaitable(task_awaitable const&) = delete;
+  task_awaitable(task_awaitable&& other) noexcept
+    : handle_(std::exchange(other.handle_, {})), state_(other.state_) {}
+  task_awaitable& operator=(task_awaitable const&) = delete;
+  task_awaitable& operator=(task_awaitable&&) = delete;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  coroutine_handle<> await_suspend(coroutine_handle<> handle) noexcept {
+    state_->continuation_ = handle;
+    return handle_;
+  }
+
+  auto await_resume() noexcept(false) {
+    return unpack_await_result(std::move(state_->result_));
+  }
+};
+
+/// Awaits the given task inside a coroutine returning a continuable,
+/// which converts the task into a continuable.
+template <typename Continuable, typename Task>
+Continuable await_task(Task task) {
+  co_return co_await std::move(task);
+}
+} // namespace awaiting
+} // namespace detail
+} // namespace cti
+#endif // defined(CONTINUABLE_HAS_COROUTINE)
+
+#endif // CONTINUABLE_DETAIL_TASK_HPP_INCLUDED
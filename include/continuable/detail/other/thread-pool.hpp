@@ -0,0 +1,601 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_THREAD_POOL_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_THREAD_POOL_HPP_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/utility/util.hpp>
+
+namespace cti {
+namespace detail {
+/// The namespace `pool` provides the work-stealing thread pool which is
+/// exposed through cti::thread_pool.
+namespace pool {
+/// The assumed size of a cache line which is used to keep the indices
+/// of a deque from false sharing.
+constexpr std::size_t cache_line_size = 64U;
+
+/// The interval in which sleeping workers look for work that is stranded
+/// in the local slot of a busy worker.
+constexpr std::chrono::milliseconds slot_poll_interval{1};
+
+/// A bounded thread local cache of the storage of work nodes.
+///
+/// Work is stored in a node while it is queued, the node is returned to the
+/// cache of the thread which executed it. Hence scheduling work does not
+/// allocate when the work is executed by the thread which scheduled it,
+/// which is the common case of chained continuations.
+class node_cache : util::non_movable {
+  static constexpr std::size_t capacity = 256U;
+
+  std::size_t size_ = 0U;
+  void* nodes_[capacity];
+
+public:
+  node_cache() = default;
+  ~node_cache() {
+    while (size_) {
+      ::operator delete(nodes_[--size_]);
+    }
+  }
+
+  void* allocate() {
+    return size_ ? nodes_[--size_] : ::operator new(sizeof(work));
+  }
+
+  void deallocate(void* node) noexcept {
+    if (size_ < capacity) {
+      nodes_[size_++] = node;
+    } else {
+      ::operator delete(node);
+    }
+  }
+
+  /// Returns the cache of the current thread
+  static node_cache& local() noexcept {
+    static thread_local node_cache cache;
+    return cache;
+  }
+};
+
+/// Moves the given work into a node of the thread local cache
+inline work* make_node(work&& task) {
+  void* node = node_cache::local().allocate();
+  return new (node) work(std::move(task));
+}
+
+/// Destroys the given work and returns its node to the thread local cache
+struct node_deleter {
+  void operator()(work* task) const noexcept {
+    task->~work();
+    node_cache::local().deallocate(task);
+  }
+};
+
+/// A lock-free work-stealing deque of work objects (Chase and Lev),
+/// with the memory orderings as described by Lê, Pop, Cohen and Nardelli.
+///
+/// Only the owning worker pushes and takes work from the bottom,
+/// while all other workers steal work from the top.
+class work_deque : util::non_movable {
+  class ring {
+    std::ptrdiff_t mask_;
+    std::unique_ptr<std::atomic<work*>[]> slots_;
+
+  public:
+    explicit ring(std::ptrdiff_t capacity)
+        : mask_(capacity - 1), slots_(new std::atomic<work*>[capacity]) {
+      assert(capacity && ((capacity & mask_) == 0) &&
+             "The capacity must be a power of two!");
+    }
+
+    std::ptrdiff_t capacity() const noexcept {
+      return mask_ + 1;
+    }
+
+    work* get(std::ptrdiff_t index) const noexcept {
+      return slots_[index & mask_].load(std::memory_order_relaxed);
+    }
+
+    void put(std::ptrdiff_t index, work* task) noexcept {
+      slots_[index & mask_].store(task, std::memory_order_relaxed);
+    }
+  };
+
+  alignas(cache_line_size) std::atomic<std::ptrdiff_t> top_{0};
+  alignas(cache_line_size) std::atomic<std::ptrdiff_t> bottom_{0};
+  std::atomic<ring*> ring_;
+  // Replaced rings are kept alive since concurrent thieves might still
+  // read from them, they are released together with the deque.
+  std::vector<std::unique_ptr<ring>> rings_;
+
+  ring* grow(ring* current, std::ptrdiff_t top, std::ptrdiff_t bottom) {
+    rings_.push_back(std::make_unique<ring>(current->capacity() * 2));
+    ring* grown = rings_.back().get();
+    for (std::ptrdiff_t i = top; i != bottom; ++i) {
+      grown->put(i, current->get(i));
+    }
+    ring_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+public:
+  explicit work_deque(std::ptrdiff_t capacity = 64) {
+    rings_.push_back(std::make_unique<ring>(capacity));
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+  }
+
+  /// Pushes the given work to the bottom, callable by the owner only
+  void push(work* task) {
+    std::ptrdiff_t const bottom = bottom_.load(std::memory_order_relaxed);
+    std::ptrdiff_t const top = top_.load(std::memory_order_acquire);
+    ring* current = ring_.load(std::memory_order_relaxed);
+    if (bottom - top > current->capacity() - 1) {
+      current = grow(current, top, bottom);
+    }
+    current->put(bottom, task);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  /// Takes the most recently pushed work, callable by the owner only
+  work* take() noexcept {
+    std::ptrdiff_t const bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    ring* current = ring_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::ptrdiff_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      // The deque is empty
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    work* task = current->get(bottom);
+    if (top == bottom) {
+      // The last work is raced against concurrent thieves
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        task = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return task;
+  }
+
+  /// Steals the least recently pushed work, callable by any thread
+  work* steal() noexcept {
+    std::ptrdiff_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::ptrdiff_t const bottom = bottom_.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+      return nullptr;
+    }
+
+    work* task = ring_.load(std::memory_order_acquire)->get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      // Lost the race against the owner or another thief
+      return nullptr;
+    }
+    return task;
+  }
+
+  /// Returns the approximated count of work inside the deque
+  std::size_t size() const noexcept {
+    std::ptrdiff_t const bottom = bottom_.load(std::memory_order_relaxed);
+    std::ptrdiff_t const top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? std::size_t(bottom - top) : 0U;
+  }
+};
+
+class thread_pool;
+
+/// The state owned by a single thread of the pool
+struct worker : util::non_movable {
+  explicit worker(thread_pool* pool, std::uint32_t seed) noexcept
+      : pool_(pool), seed_(seed) {
+  }
+
+  thread_pool* pool_;
+  work_deque deque_;
+  // The work which is executed next by this worker. The slot holds the work
+  // scheduled last by the currently executed work, which is mostly the
+  // continuation of it and therefore keeps the caches hot.
+  // Other workers only steal it when the work stays in the slot for
+  // the slot_poll_interval, since the current work might block.
+  std::atomic<work*> lifo_slot_{nullptr};
+  std::uint32_t seed_;
+  std::atomic<std::size_t> steals_{0U};
+  std::thread thread_;
+
+  /// Returns the next pseudo random number (xorshift)
+  std::uint32_t next_random() noexcept {
+    seed_ ^= seed_ << 13U;
+    seed_ ^= seed_ >> 17U;
+    seed_ ^= seed_ << 5U;
+    return seed_;
+  }
+};
+
+/// Returns the worker which is running on the current thread
+inline worker*& current_worker() noexcept {
+  static thread_local worker* current = nullptr;
+  return current;
+}
+
+/// Executes the given work and releases it afterwards
+inline void execute(work* task) noexcept {
+  std::unique_ptr<work, node_deleter> owned(task);
+  std::move(*owned)();
+}
+
+/// Cancels the given work and releases it afterwards
+inline void cancel(work&& task) noexcept {
+  std::move(task).set_canceled();
+}
+
+/// The work-stealing thread pool, see cti::thread_pool for details.
+class thread_pool : util::non_movable {
+  std::vector<std::unique_ptr<worker>> workers_;
+
+  // The queue of work which was scheduled from outside of the pool
+  std::mutex injected_mutex_;
+  std::deque<work> injected_;
+  std::atomic<std::size_t> injected_size_{0U};
+
+  // Idle workers sleep on the condition variable
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  std::atomic<std::size_t> sleepers_{0U};
+  // Is true while a sleeping worker looks for stranded slot work,
+  // guarded by the sleep_mutex_. The polling worker sleeps on its own
+  // condition variable, such that it is only woken up when no other
+  // worker sleeps.
+  bool slot_poller_ = false;
+  std::condition_variable poll_cv_;
+  std::atomic<bool> stopped_{false};
+
+public:
+  explicit thread_pool(
+      std::size_t threads = std::max(1U, std::thread::hardware_concurrency())) {
+    assert(threads && "A thread pool requires at least one thread!");
+
+    workers_.reserve(threads);
+    for (std::size_t i = 0U; i < threads; ++i) {
+      workers_.push_back(
+          std::make_unique<worker>(this, std::uint32_t(i * 0x9E3779B9U + 1U)));
+    }
+
+    // All workers need to exist before the first one can steal
+    for (auto& current : workers_) {
+      current->thread_ = std::thread([this, self = current.get()] {
+        run(*self);
+      });
+    }
+  }
+
+  ~thread_pool() {
+    assert((!current_worker() || current_worker()->pool_ != this) &&
+           "A thread pool can't be destroyed from one of its workers!");
+
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stopped_.store(true, std::memory_order_seq_cst);
+    }
+    sleep_cv_.notify_all();
+    poll_cv_.notify_all();
+
+    for (auto& current : workers_) {
+      current->thread_.join();
+    }
+
+    // Work which was scheduled concurrently to the destruction
+    // is resolved through a cancellation.
+    for (work& task : injected_) {
+      cancel(std::move(task));
+    }
+  }
+
+  /// Schedules the given work for execution on the pool
+  void schedule(work task) {
+    worker* const self = current_worker();
+    if (self && (self->pool_ == this)) {
+      // Work scheduled from a worker is kept local to the worker,
+      // work which is displaced from the slot is pushed to the deque.
+      // Only the owner fills the slot, other workers only empty it,
+      // hence an empty slot can be filled without an exchange.
+      work* node = make_node(std::move(task));
+      if (!self->lifo_slot_.load(std::memory_order_relaxed)) {
+        self->lifo_slot_.store(node, std::memory_order_release);
+      } else if (work* displaced = self->lifo_slot_.exchange(
+                     node, std::memory_order_acq_rel)) {
+        self->deque_.push(displaced);
+        notify();
+      }
+      return;
+    }
+
+    if (stopped_.load(std::memory_order_acquire)) {
+      std::move(task).set_canceled();
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(injected_mutex_);
+      injected_.push_back(std::move(task));
+      injected_size_.fetch_add(1U, std::memory_order_seq_cst);
+    }
+    notify();
+  }
+
+  std::size_t size() const noexcept {
+    return workers_.size();
+  }
+
+  std::size_t queue_depth() const noexcept {
+    std::size_t depth = queued_size();
+    for (auto const& current : workers_) {
+      if (current->lifo_slot_.load(std::memory_order_relaxed)) {
+        ++depth;
+      }
+    }
+    return depth;
+  }
+
+  std::size_t steals() const noexcept {
+    std::size_t count = 0U;
+    for (auto const& current : workers_) {
+      count += current->steals_.load(std::memory_order_relaxed);
+    }
+    return count;
+  }
+
+private:
+  void run(worker& self) {
+    current_worker() = &self;
+
+    bool steal_slots = false;
+    for (;;) {
+      if (work* task = find(self, steal_slots)) {
+        execute(task);
+        steal_slots = false;
+      } else if (!wait(steal_slots)) {
+        break;
+      }
+    }
+
+    current_worker() = nullptr;
+  }
+
+  work* find(worker& self, bool steal_slots) {
+    if (self.lifo_slot_.load(std::memory_order_relaxed)) {
+      if (work* task =
+              self.lifo_slot_.exchange(nullptr, std::memory_order_acquire)) {
+        return task;
+      }
+    }
+    if (work* task = self.deque_.take()) {
+      return task;
+    }
+    if (work* task = pop_injected()) {
+      return task;
+    }
+    if (work* task = steal(self)) {
+      return task;
+    }
+    return steal_slots ? steal_slot(self) : nullptr;
+  }
+
+  work* pop_injected() {
+    if (injected_size_.load(std::memory_order_relaxed) == 0U) {
+      return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(injected_mutex_);
+    if (injected_.empty()) {
+      return nullptr;
+    }
+    work* task = make_node(std::move(injected_.front()));
+    injected_.pop_front();
+    injected_size_.fetch_sub(1U, std::memory_order_relaxed);
+    return task;
+  }
+
+  work* steal(worker& self) {
+    std::size_t const count = workers_.size();
+    std::size_t const start = self.next_random() % count;
+    for (std::size_t i = 0U; i < count; ++i) {
+      worker& victim = *workers_[(start + i) % count];
+      if (&victim == &self) {
+        continue;
+      }
+      if (work* task = victim.deque_.steal()) {
+        self.steals_.fetch_add(1U, std::memory_order_relaxed);
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Steals the work from the local slot of another worker, whose
+  /// current work didn't take it over for a whole slot_poll_interval.
+  work* steal_slot(worker& self) {
+    for (auto& victim : workers_) {
+      if ((victim.get() != &self) &&
+          victim->lifo_slot_.load(std::memory_order_relaxed)) {
+        if (work* task = victim->lifo_slot_.exchange(
+                nullptr, std::memory_order_acquire)) {
+          self.steals_.fetch_add(1U, std::memory_order_relaxed);
+          return task;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  /// Returns the count of work inside of the queues, without the slots
+  std::size_t queued_size() const noexcept {
+    std::size_t size = injected_size_.load(std::memory_order_relaxed);
+    for (auto const& current : workers_) {
+      size += current->deque_.size();
+    }
+    return size;
+  }
+
+  bool has_work() const noexcept {
+    return queued_size() != 0U;
+  }
+
+  bool has_slot_work() const noexcept {
+    for (auto const& current : workers_) {
+      if (current->lifo_slot_.load(std::memory_order_seq_cst)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Blocks until work becomes available, returns false when the pool was
+  /// stopped and all work is done.
+  ///
+  /// Work in a local slot isn't stolen right away, since that would take
+  /// the continuation away from the worker that produced it. Instead, while
+  /// another worker is awake, one sleeping worker polls the slots in the
+  /// slot_poll_interval and takes over work which is stranded in the slot
+  /// of a blocked worker, such a take over is reported through the
+  /// steal_slots argument.
+  bool wait(bool& steal_slots) {
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleepers_.fetch_add(1U, std::memory_order_seq_cst);
+    // Pairs with the fence in notify: either the scheduling thread observes
+    // this sleeper, or this worker observes the scheduled work.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    steal_slots = false;
+    bool polled = false;
+    for (;;) {
+      if (stopped_.load(std::memory_order_relaxed)) {
+        // Slot work is taken over right away while the pool shuts down
+        sleepers_.fetch_sub(1U, std::memory_order_relaxed);
+        steal_slots = has_slot_work();
+        return steal_slots || has_work();
+      }
+      if (has_work()) {
+        break;
+      }
+      if (polled && has_slot_work()) {
+        steal_slots = true;
+        break;
+      }
+
+      if (!slot_poller_ &&
+          (sleepers_.load(std::memory_order_relaxed) < workers_.size())) {
+        slot_poller_ = true;
+        polled = poll_cv_.wait_for(lock, slot_poll_interval) ==
+                 std::cv_status::timeout;
+        slot_poller_ = false;
+      } else {
+        polled = false;
+        sleep_cv_.wait(lock);
+      }
+    }
+
+    sleepers_.fetch_sub(1U, std::memory_order_relaxed);
+
+    // Workers which went to sleep while the pool was idle don't poll,
+    // hence one of them is woken up in order to take over the polling.
+    bool const recruit =
+        !slot_poller_ && (sleepers_.load(std::memory_order_relaxed) != 0U);
+    lock.unlock();
+    if (recruit) {
+      sleep_cv_.notify_one();
+    }
+    return true;
+  }
+
+  /// Wakes up an idle worker if there is any
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) != 0U) {
+      // Synchronize with workers which are about to sleep,
+      // otherwise the notification could get lost.
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      // The polling worker is only woken up when no other worker sleeps
+      bool const poller_only =
+          slot_poller_ && (sleepers_.load(std::memory_order_relaxed) == 1U);
+      lock.unlock();
+      (poller_only ? poll_cv_ : sleep_cv_).notify_one();
+    }
+  }
+};
+
+/// The executor which schedules work on a thread_pool
+class thread_pool_executor {
+  thread_pool* pool_;
+
+public:
+  explicit thread_pool_executor(thread_pool& pool) noexcept : pool_(&pool) {
+  }
+
+  void operator()(work task) const {
+    pool_->schedule(std::move(task));
+  }
+
+  bool operator==(thread_pool_executor const& other) const noexcept {
+    return pool_ == other.pool_;
+  }
+  bool operator!=(thread_pool_executor const& other) const noexcept {
+    return pool_ != other.pool_;
+  }
+};
+} // namespace pool
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_THREAD_POOL_HPP_INCLUDED
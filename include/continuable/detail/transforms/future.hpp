@@ -32,14 +32,23 @@
 #define CONTINUABLE_DETAIL_TRANSFORMS_FUTURE_HPP_INCLUDED
 
 #include <future>
+#include <utility>
 #include <continuable/continuable-primitives.hpp>
+#include <continuable/continuable-result.hpp>
+#include <continuable/continuable-types.hpp>
 #include <continuable/detail/core/annotation.hpp>
 #include <continuable/detail/core/base.hpp>
 #include <continuable/detail/core/types.hpp>
 #include <continuable/detail/features.hpp>
+#include <continuable/detail/transforms/wait.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
+#include <continuable/detail/utility/traits.hpp>
 #include <continuable/detail/utility/util.hpp>
 
 namespace cti {
+template <typename... Args>
+class future;
+
 namespace detail {
 /// Provides helper functions to transform continuations to other types
 namespace transforms {
@@ -131,6 +140,89 @@ auto to_future(continuable_base<Data, Annotation>&& continuable) {
 
   return future;
 }
+
+/// The shared state of a cti::future which stores the result inside a
+/// wait_frame, or passes it to the continuation which was attached to it.
+template <typename... Args>
+class future_state : public util::ref_counted<future_state<Args...>> {
+  wait_frame<result<Args...>> frame_;
+  // The frame is abandoned when a continuation is attached before the
+  // result arrived, the result is passed to the continuation instead then.
+  promise<Args...> continuation_;
+
+public:
+  future_state() = default;
+
+  void resolve(result<Args...>&& value) {
+    if (!frame_.resolve(std::move(value))) {
+      forward(std::move(value));
+    }
+  }
+
+  /// Passes the result to the given promise as soon as it is available
+  template <typename Promise>
+  void attach(Promise&& continuation) {
+    continuation_ = std::forward<Promise>(continuation);
+
+    if (!frame_.abandon()) {
+      frame_.wait();
+      forward(std::move(frame_.result));
+    }
+  }
+
+  bool is_ready() const noexcept {
+    return frame_.is_ready();
+  }
+
+  void wait() {
+    frame_.wait();
+  }
+
+  template <typename Clock, typename Duration>
+  bool wait_until(std::chrono::time_point<Clock, Duration> const& deadline) {
+    return frame_.try_wait() || frame_.wait_until(deadline);
+  }
+
+  /// Blocks until the result is available and moves it out of the state
+  result<Args...> take() {
+    frame_.wait();
+    return std::move(frame_.result);
+  }
+
+private:
+  void forward(result<Args...>&& value) {
+    if (value.is_value()) {
+      traits::unpack(std::move(continuation_), std::move(value));
+    } else if (value.is_exception()) {
+      std::move(continuation_).set_exception(std::move(value).get_exception());
+    }
+    // An empty result abandons the continuation as well
+  }
+};
+
+template <typename Hint>
+struct future_state_of;
+template <typename... Args>
+struct future_state_of<identity<Args...>> {
+  using state_t = future_state<Args...>;
+  using future_t = future<Args...>;
+};
+
+/// Transforms the continuation to a cti::future
+template <typename Data, typename Annotation>
+auto to_cti_future(continuable_base<Data, Annotation>&& continuable) {
+  using state_t = typename future_state_of<Annotation>::state_t;
+  using future_t = typename future_state_of<Annotation>::future_t;
+  using result_t = typename sync_trait<Annotation>::result_t;
+
+  auto state = util::make_ref<state_t>();
+
+  std::move(continuable)
+      .next(unlocker<util::ref_ptr<state_t>, result_t>{state})
+      .done();
+
+  return future_t(std::move(state));
+}
 } // namespace transforms
 } // namespace detail
 } // namespace cti
@@ -33,15 +33,22 @@
 
 #include <atomic>
 #include <cassert>
-#include <condition_variable>
-#include <memory>
-#include <mutex>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/continuable-result.hpp>
 #include <continuable/detail/core/annotation.hpp>
 #include <continuable/detail/core/base.hpp>
+#include <continuable/detail/core/cancellation.hpp>
 #include <continuable/detail/core/types.hpp>
 #include <continuable/detail/features.hpp>
+#include <continuable/detail/utility/parking.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
 
 #if defined(CONTINUABLE_HAS_EXCEPTIONS)
 #  include <exception>
@@ -69,30 +76,164 @@ struct sync_trait<identity<Args...>> {
   using result_t = result<Args...>;
 };
 
-using lock_t = std::unique_lock<std::mutex>;
-using condition_variable_t = std::condition_variable;
+/// The phases of a wait_frame, which are combined with the parked flag
+/// inside the state word.
+enum wait_phase : std::uint32_t {
+  /// The continuation wasn't resolved yet
+  wait_pending = 0U,
+  /// The result is written by the resolving thread
+  wait_resolving = 1U,
+  /// The result is available to the waiting thread
+  wait_ready = 2U,
+  /// The waiting thread timed out and doesn't take the result anymore
+  wait_abandoned = 3U,
+  /// Is set when the waiting thread is blocked on the word
+  wait_parked = 4U
+};
+
+/// The count of times a waiting thread checks the state word before it blocks,
+/// since continuations are frequently resolved shortly after they were started.
+constexpr std::size_t wait_spin_count = 128U;
 
+/// Synchronizes the result of a continuation with a waiting thread through a
+/// single atomic word, without any locks.
 template <typename Result>
-struct unsafe_unlocker {
-  explicit unsafe_unlocker(std::atomic_bool* ready, condition_variable_t* cv,
-                           std::mutex* mutex, Result* result)
-    : ready_(ready)
-    , cv_(cv)
-    , mutex_(mutex)
-    , result_(result) {}
-
-  unsafe_unlocker(unsafe_unlocker const&) = delete;
-  unsafe_unlocker(unsafe_unlocker&&) = default;
-  unsafe_unlocker& operator=(unsafe_unlocker const&) = delete;
-  unsafe_unlocker& operator=(unsafe_unlocker&&) = default;
-
-  ~unsafe_unlocker() {
+struct wait_frame {
+  util::parking::word_t state{wait_pending};
+  Result result;
+
+  /// Publishes the result to the waiting thread, returns false and leaves
+  /// the result untouched when the frame was abandoned already.
+  bool resolve(Result&& value) {
+    std::uint32_t current = state.load(std::memory_order_acquire);
+    do {
+      if ((current & ~std::uint32_t(wait_parked)) == wait_abandoned) {
+        return false;
+      }
+    } while (!state.compare_exchange_weak(
+        current, (current & wait_parked) | wait_resolving,
+        std::memory_order_acquire, std::memory_order_acquire));
+
+    result = std::move(value);
+
+    if (state.exchange(wait_ready, std::memory_order_acq_rel) & wait_parked) {
+      // The frame can be released as soon as the state is ready,
+      // which is fine since waking only uses the address of the word.
+      util::parking::wake_all(&state);
+    }
+    return true;
+  }
+
+  /// Blocks until the result is ready
+  void wait() {
+    std::uint32_t current = spin();
+    while (current != wait_ready) {
+      current = park(current);
+      if (current == wait_ready) {
+        // The result was published while the parked flag was set
+        break;
+      }
+
+      util::parking::wait(state, current);
+      current = state.load(std::memory_order_acquire);
+    }
+  }
+
+  /// Blocks until the result is ready or the given time point was reached,
+  /// returns false on timeout.
+  template <typename Clock, typename Duration>
+  bool wait_until(std::chrono::time_point<Clock, Duration> const& deadline) {
+    std::uint32_t current = spin();
+    while (current != wait_ready) {
+      auto const remaining = deadline - Clock::now();
+      if (remaining <= std::chrono::nanoseconds::zero()) {
+        return false;
+      }
+
+      current = park(current);
+      if (current == wait_ready) {
+        break;
+      }
+
+      util::parking::wait_for(
+          state, current,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+      current = state.load(std::memory_order_acquire);
+    }
+    return true;
+  }
+
+  /// Marks the frame as abandoned such that the result is dropped, returns
+  /// false if the result is published already, or is about to be published.
+  bool abandon() noexcept {
+    std::uint32_t current = state.load(std::memory_order_acquire);
+    while ((current & ~std::uint32_t(wait_parked)) == wait_pending) {
+      if (state.compare_exchange_weak(current, wait_abandoned,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Returns true if the result is ready without blocking
+  bool is_ready() const noexcept {
+    return state.load(std::memory_order_acquire) == wait_ready;
+  }
+
+  /// Spins for a bounded time and returns true if the result is ready
+  bool try_wait() const noexcept {
+    return spin() == wait_ready;
+  }
+
+private:
+  std::uint32_t spin() const noexcept {
+    std::uint32_t current = state.load(std::memory_order_acquire);
+    for (std::size_t i = 0U; (i < wait_spin_count) && (current != wait_ready);
+         ++i) {
+      util::parking::relax();
+      current = state.load(std::memory_order_acquire);
+    }
+    return current;
+  }
+
+  /// Sets the parked flag and returns the state word to block on
+  std::uint32_t park(std::uint32_t current) noexcept {
+    while (!(current & wait_parked) && (current != wait_ready)) {
+      if (state.compare_exchange_weak(current, current | wait_parked,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+        return current | wait_parked;
+      }
+    }
+    return current;
+  }
+};
+
+/// A wait_frame which outlives the waiting thread when its wait timed out
+template <typename Result>
+struct shared_wait_frame : wait_frame<Result>,
+                           util::ref_counted<shared_wait_frame<Result>> {};
+
+/// Resolves the wait_frame which is referenced through the given pointer
+template <typename FramePtr, typename Result>
+struct unlocker {
+  explicit unlocker(FramePtr frame) : frame_(std::move(frame)) {
+  }
+
+  unlocker(unlocker const&) = delete;
+  unlocker(unlocker&&) = default;
+  unlocker& operator=(unlocker const&) = delete;
+  unlocker& operator=(unlocker&&) = default;
+
+  ~unlocker() {
     unlock(Result::empty());
   }
 
   template <typename... Args>
   void operator()(Args&&... args) {
-    unlock(Result::from(std::forward<Args>(args)...));
+    unlock(Result::from(std::forward<decltype(args)>(args)...));
   }
 
   void unlock(Result&& result) {
@@ -101,20 +242,10 @@ struct unsafe_unlocker {
     }
     ownership_.release();
 
-    lock_t lock(*mutex_);
-
-    *result_ = std::move(result);
-
-    assert(!ready_->load(std::memory_order_acquire));
-    ready_->store(true, std::memory_order_release);
-
-    cv_->notify_all();
+    frame_->resolve(std::move(result));
   }
 
-  std::atomic_bool* ready_;
-  condition_variable_t* cv_;
-  std::mutex* mutex_;
-  Result* result_;
+  FramePtr frame_;
   util::ownership ownership_;
 };
 
@@ -127,38 +258,21 @@ Result wait_relaxed(continuable_base<Data, Annotation>&& continuable) {
     return std::move(continuable).unpack();
   }
 
-  condition_variable_t cv;
-  std::mutex cv_mutex;
-
-  std::atomic_bool ready{false};
-  Result sync_result;
+  // The waiting thread always takes the result,
+  // hence the frame can be placed on its stack.
+  wait_frame<Result> frame;
 
   std::move(continuable)
-      .next(unsafe_unlocker<Result>{
-          &ready,
-          &cv,
-          &cv_mutex,
-          &sync_result,
-      })
+      .next(unlocker<wait_frame<Result>*, Result>{&frame})
       .done();
 
-  lock_t lock(cv_mutex);
-  if (!ready.load(std::memory_order_acquire)) {
-    cv.wait(lock, [&] {
-      return ready.load(std::memory_order_acquire);
-    });
-  }
-
-  return sync_result;
+  frame.wait();
+  return std::move(frame.result);
 }
 
-/// Transforms the continuation to sync execution and unpacks the result the if
-/// possible
-template <typename Data, typename Annotation>
-auto wait_and_unpack(continuable_base<Data, Annotation>&& continuable) {
-
-  auto sync_result = wait_relaxed(std::move(continuable));
-
+/// Returns the value of the result, or rethrows its exception
+template <typename Result>
+auto unpack_sync_result(Result sync_result) {
 #if defined(CONTINUABLE_HAS_EXCEPTIONS)
   if (sync_result.is_value()) {
     return std::move(sync_result).get_value();
@@ -176,86 +290,266 @@ auto wait_and_unpack(continuable_base<Data, Annotation>&& continuable) {
 #endif // CONTINUABLE_HAS_EXCEPTIONS
 }
 
+/// Transforms the continuation to sync execution and unpacks the result the if
+/// possible
+template <typename Data, typename Annotation>
+auto wait_and_unpack(continuable_base<Data, Annotation>&& continuable) {
+  return unpack_sync_result(wait_relaxed(std::move(continuable)));
+}
+
+/// Returns the time point of the timeout from now on
+template <typename Rep, typename Period>
+auto deadline_of(std::chrono::duration<Rep, Period> const& duration) {
+  return std::chrono::steady_clock::now() + duration;
+}
+template <typename Clock, typename Duration>
+auto deadline_of(std::chrono::time_point<Clock, Duration> const& time_point) {
+  return time_point;
+}
+
+template <typename Data, typename Annotation, typename Timeout,
+          typename Result = typename sync_trait<Annotation>::result_t>
+Result wait_unsafe(continuable_base<Data, Annotation>&& continuable,
+                   Timeout timeout) {
+
+  // Do an immediate unpack if the continuable is ready
+  if (continuable.is_ready()) {
+    return std::move(continuable).unpack();
+  }
+
+  using frame_t = shared_wait_frame<Result>;
+
+  // The continuation might be resolved after the wait timed out,
+  // therefore the frame is shared with the continuation.
+  auto frame = util::make_ref<frame_t>();
+
+  std::move(continuable)
+      .next(unlocker<util::ref_ptr<frame_t>, Result>{frame})
+      .done();
+
+  // The clock is only read when the result isn't available shortly
+  if (frame->try_wait() || frame->wait_until(deadline_of(timeout)) ||
+      !frame->abandon()) {
+    // The result might still be written after the timeout
+    frame->wait();
+    return std::move(frame->result);
+  } else {
+    return Result::empty();
+  }
+}
+
+/// A countdown latch on a single state word which wakes the waiting thread
+/// once, when the count reached zero.
+class wait_latch {
+  // The count is stored above the parked flag in the lowest bit
+  util::parking::word_t state_;
+
+public:
+  explicit wait_latch(std::size_t count) noexcept
+      : state_(static_cast<std::uint32_t>(count << 1U)) {
+    assert((count < (std::size_t(1U) << 31U)) &&
+           "The count exceeds the capacity of the latch!");
+  }
+
+  void count_down() {
+    std::uint32_t const previous =
+        state_.fetch_sub(2U, std::memory_order_acq_rel);
+    assert((previous >> 1U) > 0U);
+
+    if (((previous >> 1U) == 1U) && (previous & 1U)) {
+      util::parking::wake_all(&state_);
+    }
+  }
+
+  /// Blocks until the count reached zero
+  void wait() {
+    std::uint32_t current = state_.load(std::memory_order_acquire);
+    for (std::size_t i = 0U; (i < wait_spin_count) && (current >> 1U); ++i) {
+      util::parking::relax();
+      current = state_.load(std::memory_order_acquire);
+    }
+
+    while (current >> 1U) {
+      if (!(current & 1U) &&
+          !state_.compare_exchange_weak(current, current | 1U,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+        continue;
+      }
+
+      util::parking::wait(state_, current | 1U);
+      current = state_.load(std::memory_order_acquire);
+    }
+  }
+};
+
+/// Stores the results of all continuables of a batch,
+/// which are resolved before the waiting thread returns.
 template <typename Result>
-struct wait_frame {
-  std::mutex cv_mutex;
-  std::mutex rw_mutex;
-  condition_variable_t cv;
-  std::atomic_bool ready{false};
-  Result sync_result;
+struct wait_all_frame {
+  std::vector<Result> results;
+  wait_latch latch;
+
+  explicit wait_all_frame(std::size_t count)
+      : results(count), latch(count) {
+  }
+
+  void resolve(std::size_t index, Result&& result) {
+    results[index] = std::move(result);
+    latch.count_down();
+  }
+
+  /// Continuables of the batch aren't cancelled
+  cancellation::cancellation_state* get_cancellation_state() const noexcept {
+    return nullptr;
+  }
 };
 
+/// Stores the first result of a batch, the frame outlives the waiting thread
+/// since the remaining continuables are resolved afterwards.
 template <typename Result>
-struct unlocker {
-  unlocker(unlocker const&) = delete;
-  unlocker(unlocker&&) = default;
-  unlocker& operator=(unlocker const&) = delete;
-  unlocker& operator=(unlocker&&) = default;
+struct wait_any_frame : util::ref_counted<wait_any_frame<Result>> {
+  std::vector<Result> results;
+  wait_latch latch{1U};
+  std::atomic<bool> finished{false};
+  // Is cancelled when the first result arrived, such that the remaining
+  // continuables can abandon their work.
+  util::ref_ptr<cancellation::cancellation_state> cancellation =
+      util::make_ref<cancellation::cancellation_state>();
+
+  explicit wait_any_frame(std::size_t count) : results(count) {
+  }
 
-  explicit unlocker(std::weak_ptr<wait_frame<Result>> frame)
-    : frame_(std::move(frame)) {}
+  void resolve(std::size_t index, Result&& result) {
+    if (!finished.load(std::memory_order_relaxed) &&
+        !finished.exchange(true, std::memory_order_acquire)) {
+      results[index] = std::move(result);
+      cancellation->cancel();
+      latch.count_down();
+    }
+  }
 
-  ~unlocker() {
+  cancellation::cancellation_state* get_cancellation_state() const noexcept {
+    return cancellation.get();
+  }
+};
+
+/// Resolves the result at the given index of a batch frame
+template <typename FramePtr, typename Result>
+class batch_callback {
+  FramePtr frame_;
+  std::size_t index_;
+  util::ownership ownership_;
+
+public:
+  explicit batch_callback(FramePtr frame, std::size_t index)
+      : frame_(std::move(frame)), index_(index) {
+  }
+
+  batch_callback(batch_callback const&) = delete;
+  batch_callback(batch_callback&&) = default;
+  batch_callback& operator=(batch_callback const&) = delete;
+  batch_callback& operator=(batch_callback&&) = default;
+
+  ~batch_callback() {
     unlock(Result::empty());
   }
 
   template <typename... Args>
   void operator()(Args&&... args) {
-    unlock(Result::from(std::forward<decltype(args)>(args)...));
+    unlock(Result::from(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  void set_value(Args&&... args) {
+    unlock(Result::from(std::forward<Args>(args)...));
+  }
+
+  void set_exception(exception_t exception) {
+    unlock(Result::from(exception_arg_t{}, std::move(exception)));
+  }
+
+  void set_canceled() {
+    unlock(Result::from(exception_arg_t{}, exception_t{}));
+  }
+
+  bool is_cancelled() const noexcept {
+    return cancellation::is_cancelled(*this);
+  }
+
+  cancellation::cancellation_state* get_cancellation_state() const noexcept {
+    return frame_->get_cancellation_state();
+  }
+
+  explicit operator bool() const noexcept {
+    return true;
   }
 
+private:
   void unlock(Result&& result) {
     if (!ownership_.is_acquired()) {
       return;
     }
     ownership_.release();
 
-    if (auto locked = frame_.lock()) {
-      {
-        std::lock_guard<std::mutex> rw_lock(locked->rw_mutex);
-        assert(!locked->ready.load(std::memory_order_acquire));
-        locked->sync_result = std::move(result);
-      }
-
-      locked->ready.store(true, std::memory_order_release);
-      locked->cv.notify_all();
-    }
+    frame_->resolve(index_, std::move(result));
   }
-
-  std::weak_ptr<wait_frame<Result>> frame_;
-  util::ownership ownership_;
 };
 
-template <typename Data, typename Annotation, typename Waiter,
-          typename Result = typename sync_trait<Annotation>::result_t>
-Result wait_unsafe(continuable_base<Data, Annotation>&& continuable,
-                   Waiter&& waiter) {
+template <typename T>
+struct batch_trait;
+template <typename Data, typename Annotation>
+struct batch_trait<continuable_base<Data, Annotation>> {
+  using result_t = typename sync_trait<Annotation>::result_t;
+};
 
-  // Do an immediate unpack if the continuable is ready
-  if (continuable.is_ready()) {
-    return std::move(continuable).unpack();
+template <typename Iterator>
+using batch_result_t = typename batch_trait<
+    typename std::iterator_traits<Iterator>::value_type>::result_t;
+
+/// Starts all continuables of the range and blocks until all of them
+/// were resolved.
+template <typename Iterator, typename Result = batch_result_t<Iterator>>
+std::vector<Result> wait_all(Iterator begin, Iterator end) {
+  std::size_t const count =
+      static_cast<std::size_t>(std::distance(begin, end));
+
+  // All continuables are resolved before the waiting thread returns,
+  // hence the frame can be placed on its stack.
+  wait_all_frame<Result> frame(count);
+
+  for (std::size_t index = 0U; begin != end; ++begin) {
+    base::invoke_continuation(
+        std::move(*begin),
+        batch_callback<wait_all_frame<Result>*, Result>(&frame, index++));
   }
 
-  using frame_t = wait_frame<Result>;
+  frame.latch.wait();
+  return std::move(frame.results);
+}
 
-  auto frame = std::make_shared<frame_t>();
+/// Starts all continuables of the range and blocks until the first one
+/// was resolved.
+template <typename Iterator, typename Result = batch_result_t<Iterator>>
+std::vector<Result> wait_any(Iterator begin, Iterator end) {
+  std::size_t const count =
+      static_cast<std::size_t>(std::distance(begin, end));
 
-  std::move(continuable)
-      .next(unlocker<Result>{std::weak_ptr<frame_t>(frame)})
-      .done();
+  if (count == 0U) {
+    return {};
+  }
+
+  using frame_t = wait_any_frame<Result>;
+  auto frame = util::make_ref<frame_t>(count);
 
-  if (!frame->ready.load(std::memory_order_acquire)) {
-    lock_t lock(frame->cv_mutex);
-    std::forward<Waiter>(waiter)(frame->cv, lock, [&] {
-      return frame->ready.load(std::memory_order_acquire);
-    });
+  for (std::size_t index = 0U; begin != end; ++begin) {
+    base::invoke_continuation(
+        std::move(*begin),
+        batch_callback<util::ref_ptr<frame_t>, Result>(frame, index++));
   }
 
-  return ([&] {
-    std::lock_guard<std::mutex> rw_lock(frame->rw_mutex);
-    Result cached = std::move(frame->sync_result);
-    return cached;
-  })();
+  frame->latch.wait();
+  return std::move(frame->results);
 }
 } // namespace transforms
 } // namespace detail
@@ -40,6 +40,7 @@
 #include <type_traits>
 #include <utility>
 #include <continuable/detail/traversal/container-category.hpp>
+#include <continuable/detail/utility/ref-counted.hpp>
 #include <continuable/detail/utility/traits.hpp>
 
 namespace cti {
@@ -143,6 +144,12 @@ public:
   }
 };
 
+/// Deduces to a true type if the visitor is reference counted intrusively
+/// through util::ref_counted instead of std::enable_shared_from_this.
+template <typename Visitor>
+using is_ref_counted_visitor =
+    std::is_base_of<util::ref_counted<Visitor>, Visitor>;
+
 template <typename Visitor, typename... Args>
 using data_layout_t =
     std::conditional_t<has_head<Visitor>::value,
@@ -164,6 +171,15 @@ class async_traversal_frame : public data_layout_t<Visitor, Args...> {
     return *static_cast<Visitor const*>(this);
   }
 
+  /// Returns a new owning handle to this frame
+  auto handle_of(std::false_type /*is_ref_counted_visitor*/) {
+    return std::static_pointer_cast<async_traversal_frame>(
+        this->shared_from_this());
+  }
+  auto handle_of(std::true_type /*is_ref_counted_visitor*/) {
+    return util::ref_of(this);
+  }
+
 public:
   template <typename... T>
   explicit async_traversal_frame(T&&... args)
@@ -191,8 +207,7 @@ public:
   template <typename T, typename Hierarchy>
   void async_continue(T&& value, Hierarchy&& hierarchy) {
     // Cast the frame up
-    auto frame = std::static_pointer_cast<async_traversal_frame>(
-        this->shared_from_this());
+    auto frame = handle_of(is_ref_counted_visitor<Visitor>{});
 
     // Create a callable object which resumes the current
     // traversal when it's called.
@@ -531,6 +546,26 @@ struct async_traversal_types {
   using visitor_t = Visitor;
 };
 
+/// Allocates the frame and returns an owning handle to it
+template <typename Frame, typename... Args>
+auto make_frame(std::false_type /*is_ref_counted_visitor*/, Args&&... args) {
+  return std::make_shared<Frame>(std::forward<Args>(args)...);
+}
+template <typename Frame, typename... Args>
+auto make_frame(std::true_type /*is_ref_counted_visitor*/, Args&&... args) {
+  return util::make_ref<Frame>(std::forward<Args>(args)...);
+}
+
+/// Casts the owning handle of the frame down to the visitor type
+template <typename Visitor, typename Frame>
+auto demote_frame(std::shared_ptr<Frame> frame) {
+  return std::static_pointer_cast<Visitor>(std::move(frame));
+}
+template <typename Visitor, typename Frame>
+auto demote_frame(util::ref_ptr<Frame> frame) {
+  return util::ref_ptr<Visitor>(std::move(frame));
+}
+
 template <typename Visitor, typename VisitorArg, typename... Args>
 struct async_traversal_types<async_traverse_in_place_tag<Visitor>, VisitorArg,
                              Args...>
@@ -545,9 +580,12 @@ auto apply_pack_transform_async(Visitor&& visitor, Args&&... args) {
   using frame_t = typename types::frame_t;
   using visitor_t = typename types::visitor_t;
 
+  using is_ref_counted = is_ref_counted_visitor<visitor_t>;
+
   // Check whether the visitor inherits enable_shared_from_this
-  static_assert(std::is_base_of<std::enable_shared_from_this<visitor_t>,
-                                visitor_t>::value,
+  static_assert(is_ref_counted::value ||
+                    std::is_base_of<std::enable_shared_from_this<visitor_t>,
+                                    visitor_t>::value,
                 "The visitor must inherit std::enable_shared_from_this!");
 
   // Check whether the visitor is virtual destructible
@@ -557,8 +595,9 @@ auto apply_pack_transform_async(Visitor&& visitor, Args&&... args) {
   // Create the frame on the heap which stores the arguments
   // to traverse asynchronous. It persists until the
   // traversal frame isn't referenced anymore.
-  auto frame = std::make_shared<frame_t>(std::forward<Visitor>(visitor),
-                                         std::forward<Args>(args)...);
+  auto frame = make_frame<frame_t>(is_ref_counted{},
+                                   std::forward<Visitor>(visitor),
+                                   std::forward<Args>(args)...);
 
   // Create a static range for the top level tuple
   auto range = std::make_tuple(make_static_range(frame->head()));
@@ -571,7 +610,7 @@ auto apply_pack_transform_async(Visitor&& visitor, Args&&... args) {
 
   // Cast the shared_ptr down to the given visitor type
   // for implementation invisibility
-  return std::static_pointer_cast<visitor_t>(std::move(frame));
+  return demote_frame<visitor_t>(std::move(frame));
 }
 } // namespace traversal
 } // namespace detail
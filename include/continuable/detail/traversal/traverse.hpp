@@ -255,7 +255,7 @@ constexpr auto flat_arraylize_to(T&&... args)
 template <typename First, typename... Rest>
 constexpr std::tuple<First, Rest...>
 voidify_empty_tuple(std::tuple<First, Rest...> val) {
-  return std::move(val);
+  return val;
 }
 inline void voidify_empty_tuple(std::tuple<>) noexcept {
 }
@@ -0,0 +1,80 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_INTRUSIVE_QUEUE_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_INTRUSIVE_QUEUE_HPP_INCLUDED
+
+namespace cti {
+namespace detail {
+namespace util {
+/// A first-in first-out list of nodes which are linked through their
+/// next pointer, such that queueing a node doesn't allocate.
+///
+/// The queue doesn't own its nodes and isn't thread-safe.
+template <typename Node>
+class intrusive_queue {
+  Node* head_ = nullptr;
+  Node* tail_ = nullptr;
+
+public:
+  bool empty() const noexcept {
+    return head_ == nullptr;
+  }
+
+  Node* front() const noexcept {
+    return head_;
+  }
+
+  void push_back(Node* node) noexcept {
+    node->next = nullptr;
+    if (tail_) {
+      tail_->next = node;
+    } else {
+      head_ = node;
+    }
+    tail_ = node;
+  }
+
+  Node* pop_front() noexcept {
+    Node* node = head_;
+    if (node) {
+      head_ = node->next;
+      if (!head_) {
+        tail_ = nullptr;
+      }
+    }
+    return node;
+  }
+};
+} // namespace util
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_INTRUSIVE_QUEUE_HPP_INCLUDED
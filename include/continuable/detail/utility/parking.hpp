@@ -0,0 +1,161 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_UTILITY_PARKING_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_UTILITY_PARKING_HPP_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#  include <climits>
+#  include <ctime>
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#else
+#  include <condition_variable>
+#  include <cstddef>
+#  include <mutex>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#  include <intrin.h>
+#endif
+
+namespace cti {
+namespace detail {
+namespace util {
+/// Provides the blocking of threads on a single atomic word, which is backed
+/// by a futex on Linux and by a fixed table of condition variables which is
+/// shared by all words on other platforms.
+///
+/// Waiting may return spuriously, hence callers have to recheck the word.
+/// Waking only uses the address of the word, so it is safe to wake a word
+/// whose storage was released by the waiting thread meanwhile.
+namespace parking {
+/// The type of the word threads can block on
+using word_t = std::atomic<std::uint32_t>;
+
+/// Hints the processor that the calling thread is spinning on a word
+inline void relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) &&                             \
+    (defined(__i386__) || defined(__x86_64__))
+  __builtin_ia32_pause();
+#endif
+}
+
+#if defined(__linux__)
+static_assert(sizeof(word_t) == sizeof(std::uint32_t),
+              "The word needs to have the layout of a futex!");
+
+inline long futex(word_t* word, int op, std::uint32_t value,
+                  timespec const* timeout) noexcept {
+  return syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), op, value,
+                 timeout, nullptr, 0);
+}
+
+/// Blocks the calling thread as long as the word is equal to expected
+inline void wait(word_t& word, std::uint32_t expected) noexcept {
+  futex(&word, FUTEX_WAIT_PRIVATE, expected, nullptr);
+}
+
+/// Blocks the calling thread as long as the word is equal to expected,
+/// at most for the given duration.
+inline void wait_for(word_t& word, std::uint32_t expected,
+                     std::chrono::nanoseconds duration) noexcept {
+  if (duration <= std::chrono::nanoseconds::zero()) {
+    return;
+  }
+
+  auto const seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(duration);
+  timespec timeout;
+  timeout.tv_sec = static_cast<std::time_t>(seconds.count());
+  timeout.tv_nsec = static_cast<long>((duration - seconds).count());
+  futex(&word, FUTEX_WAIT_PRIVATE, expected, &timeout);
+}
+
+/// Wakes all threads which are blocked on the given word
+inline void wake_all(word_t* word) noexcept {
+  futex(word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+}
+#else
+struct bucket {
+  std::mutex mutex;
+  std::condition_variable cv;
+};
+
+inline bucket& bucket_of(word_t const* word) noexcept {
+  static constexpr std::size_t size = 64U;
+  static bucket buckets[size];
+  return buckets[(reinterpret_cast<std::uintptr_t>(word) >> 4U) % size];
+}
+
+/// Blocks the calling thread as long as the word is equal to expected
+inline void wait(word_t& word, std::uint32_t expected) {
+  bucket& current = bucket_of(&word);
+  std::unique_lock<std::mutex> lock(current.mutex);
+  if (word.load(std::memory_order_acquire) == expected) {
+    current.cv.wait(lock);
+  }
+}
+
+/// Blocks the calling thread as long as the word is equal to expected,
+/// at most for the given duration.
+inline void wait_for(word_t& word, std::uint32_t expected,
+                     std::chrono::nanoseconds duration) {
+  bucket& current = bucket_of(&word);
+  std::unique_lock<std::mutex> lock(current.mutex);
+  if (word.load(std::memory_order_acquire) == expected) {
+    current.cv.wait_for(lock, duration);
+  }
+}
+
+/// Wakes all threads which are blocked on the given word
+inline void wake_all(word_t* word) {
+  bucket& current = bucket_of(word);
+  {
+    // Waiters check the word while holding the lock, so acquiring it once
+    // orders the modification of the word before their check.
+    std::lock_guard<std::mutex> lock(current.mutex);
+  }
+  current.cv.notify_all();
+}
+#endif
+} // namespace parking
+} // namespace util
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_UTILITY_PARKING_HPP_INCLUDED
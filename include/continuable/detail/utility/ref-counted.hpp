@@ -0,0 +1,162 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v4.2.0
+
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_REF_COUNTED_HPP_INCLUDED
+#define CONTINUABLE_DETAIL_REF_COUNTED_HPP_INCLUDED
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <continuable/detail/utility/util.hpp>
+
+namespace cti {
+namespace detail {
+namespace util {
+/// Provides an intrusive and thread-safe reference count for objects
+/// which are shared between multiple callbacks, such as the shared state
+/// of connections and loops.
+///
+/// The object is created with a reference count of one which is owned by its
+/// creator. The release of the last reference deletes the object through
+/// a pointer to T, hence T needs a virtual destructor if derived types are
+/// deleted through it.
+template <typename T>
+class ref_counted : non_movable {
+  std::atomic<std::size_t> references_{1U};
+
+public:
+  /// Acquires an additional reference to this object
+  void acquire_ref() noexcept {
+    references_.fetch_add(1U, std::memory_order_relaxed);
+  }
+
+  /// Releases a reference to this object and deletes it,
+  /// when the last reference was released.
+  void release_ref() noexcept {
+    assert(references_.load(std::memory_order_relaxed) > 0U);
+
+    if (references_.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+      delete static_cast<T*>(this);
+    }
+  }
+};
+
+/// An owning handle to a ref_counted object which owns exactly one reference
+/// of the object.
+///
+/// In contrast to a std::shared_ptr the handle has the size of a raw pointer,
+/// and it doesn't require an additional control block or a weak count.
+template <typename T>
+class ref_ptr {
+  template <typename>
+  friend class ref_ptr;
+
+  T* ptr_;
+
+public:
+  ref_ptr() noexcept : ptr_(nullptr) {
+  }
+  /// Takes the ownership over an already acquired reference of the object
+  explicit ref_ptr(T* ptr) noexcept : ptr_(ptr) {
+  }
+  ref_ptr(ref_ptr const& other) noexcept : ptr_(other.ptr_) {
+    if (ptr_) {
+      ptr_->acquire_ref();
+    }
+  }
+  ref_ptr(ref_ptr&& other) noexcept : ptr_(std::exchange(other.ptr_, nullptr)) {
+  }
+  template <typename O,
+            std::enable_if_t<std::is_convertible<O*, T*>::value>* = nullptr>
+  /* implicit */ ref_ptr(ref_ptr<O>&& other) noexcept
+      : ptr_(std::exchange(other.ptr_, nullptr)) {
+  }
+  ~ref_ptr() {
+    if (ptr_) {
+      ptr_->release_ref();
+    }
+  }
+
+  ref_ptr& operator=(ref_ptr const& other) noexcept {
+    ref_ptr(other).swap(*this);
+    return *this;
+  }
+  ref_ptr& operator=(ref_ptr&& other) noexcept {
+    ref_ptr(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  void swap(ref_ptr& other) noexcept {
+    std::swap(ptr_, other.ptr_);
+  }
+
+  /// Releases the ownership of the reference without releasing it
+  T* release() noexcept {
+    return std::exchange(ptr_, nullptr);
+  }
+
+  T* get() const noexcept {
+    return ptr_;
+  }
+  T* operator->() const noexcept {
+    assert(ptr_);
+    return ptr_;
+  }
+  T& operator*() const noexcept {
+    assert(ptr_);
+    return *ptr_;
+  }
+
+  explicit operator bool() const noexcept {
+    return ptr_ != nullptr;
+  }
+};
+
+/// Allocates the given ref_counted type T and returns the handle which owns
+/// the initial reference of it.
+template <typename T, typename... Args>
+ref_ptr<T> make_ref(Args&&... args) {
+  return ref_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+/// Acquires an additional reference to the given ref_counted object
+template <typename T>
+ref_ptr<T> ref_of(T* ptr) noexcept {
+  assert(ptr);
+  ptr->acquire_ref();
+  return ref_ptr<T>(ptr);
+}
+} // namespace util
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_REF_COUNTED_HPP_INCLUDED
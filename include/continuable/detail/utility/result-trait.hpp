@@ -62,7 +62,7 @@ struct result_trait<T> {
   using surrogate_t = value_t;
 
   static surrogate_t wrap(T arg) {
-    return std::move(arg);
+    return arg;
   }
 
   template <typename R>
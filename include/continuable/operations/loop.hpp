@@ -31,6 +31,7 @@
 #ifndef CONTINUABLE_OPERATIONS_LOOP_HPP_INCLUDED
 #define CONTINUABLE_OPERATIONS_LOOP_HPP_INCLUDED
 
+#include <cstddef>
 #include <utility>
 #include <continuable/continuable-primitives.hpp>
 #include <continuable/continuable-result.hpp>
@@ -135,6 +136,55 @@ auto range_loop(Callable&& callable, Iterator begin, Iterator end) {
                                             begin, end));
 }
 
+/// Can be used to create an asynchronous loop over a specific range,
+/// which keeps up to limit iterations in flight at the same time.
+///
+/// The callable is invoked with the iterator once for every element of the
+/// range, and a new iteration is started as soon as a running one completes.
+/// The range is advanced lazily, hence input iterators and generators
+/// are never materialized into a container:
+/// ```cpp
+/// auto store_all(std::istream& keys) {
+///   // Keep at most 16 requests to the backend in flight
+///   return for_each_concurrent([](std::istream_iterator<std::string> key) {
+///     return store(*key);
+///   }, std::istream_iterator<std::string>(keys),
+///      std::istream_iterator<std::string>(), 16);
+/// }
+/// ```
+///
+/// The first failing iteration stops the launch of further iterations and
+/// the returned continuable is resolved with its exception, after all
+/// iterations which were running already completed.
+///
+/// \param callable The callable type which must return a cti::continuable_base
+///        which resolves to arbitrary values that are ignored. The iterator is
+///        advanced as soon as the callable returned, therefore it has to
+///        dereference the iterator before returning.
+///
+/// \param begin The iterator to iterate over
+///
+/// \param end The iterator or sentinel to iterate until
+///
+/// \param limit The maximum count of iterations which are in flight,
+///              a limit of 0 is treated as 1.
+///
+/// \returns A cti::continuable_base without arguments which is resolved
+///          when all iterations completed.
+///
+/// \attention The iterator is only accessed by one thread at a time,
+///            although iterations can complete on arbitrary threads.
+///
+/// \since 4.3.0
+///
+template <typename Callable, typename Begin, typename End>
+auto for_each_concurrent(Callable&& callable, Begin begin, End end,
+                         std::size_t limit) {
+  return detail::operations::loop_concurrent(std::forward<Callable>(callable),
+                                             std::move(begin), std::move(end),
+                                             limit);
+}
+
 /// \}
 } // namespace cti
 
@@ -70,9 +70,12 @@ namespace cti {
 /// };
 /// ```
 ///
-/// \note The split function only works if all asynchronous arguments are
-///       copyable. All asynchronous arguments and exceptions will be passed
-///       to all split promises.
+/// \note All asynchronous arguments and exceptions will be passed
+///       to all split promises. The first given promise is resolved last
+///       and receives the arguments as rvalues, while all others receive
+///       them as lvalues. Use cti::split_as_const to pass const lvalues
+///       instead, or cti::split_shared to avoid copying large arguments
+///       for every promise.
 ///
 /// \param promises The promises to split the control flow into,
 ///                 can be single promises or heterogeneous or homogeneous
@@ -87,6 +90,74 @@ namespace cti {
 template <typename... Promises>
 auto split(Promises&&... promises) {
   return detail::operations::split_promise<
+      false, detail::traits::unrefcv_t<Promises>...>(
+      std::forward<Promises>(promises)...);
+}
+
+/// Splits the asynchronous control flow like cti::split, but passes the
+/// asynchronous arguments as const lvalues to all promises except the
+/// first given one, which is resolved last and receives them as rvalues.
+///
+/// Hence none of the promises can modify the arguments another promise
+/// observes, and move-only arguments can be split when only the first
+/// promise takes them by value:
+/// ```cpp
+/// cti::promise<std::unique_ptr<frame>> resolver = cti::split_as_const(
+///     std::move(owner), [](std::unique_ptr<frame> const& current) {
+///       // ...
+///     });
+/// ```
+///
+/// \param promises The promises to split the control flow into,
+///                 can be single promises or heterogeneous or homogeneous
+///                 containers of promises (see traverse_pack for a description
+///                 of supported nested arguments).
+///
+/// \returns A new promise with the same asynchronous result types as
+///          the given promises.
+///
+/// \since 4.3.0
+///
+template <typename... Promises>
+auto split_as_const(Promises&&... promises) {
+  return detail::operations::split_promise<
+      true, detail::traits::unrefcv_t<Promises>...>(
+      std::forward<Promises>(promises)...);
+}
+
+/// Splits the asynchronous control flow like cti::split, but wraps
+/// every asynchronous argument exactly once into an immutable and
+/// reference counted `std::shared_ptr<T const>`, which is passed to all
+/// given promises instead of a copy of the argument.
+///
+/// This makes it possible to broadcast large or move-only arguments to
+/// many consumers without copying those:
+/// ```cpp
+/// std::vector<cti::promise<std::shared_ptr<snapshot const>>> subscribers;
+///
+/// cti::promise<snapshot> resolver =
+///     cti::split_shared(std::move(subscribers));
+///
+/// // The snapshot is moved into a single holder shared by all subscribers
+/// resolver.set_value(take_snapshot());
+/// ```
+///
+/// \param promises The promises to split the control flow into, which
+///                 accept a `std::shared_ptr<T const>` for every
+///                 asynchronous argument of type `T`. Those can be single
+///                 promises or heterogeneous or homogeneous containers of
+///                 promises (see traverse_pack for a description of
+///                 supported nested arguments).
+///
+/// \returns A new promise which accepts the arguments the shared handles
+///          are created from. Exceptions are passed unchanged to all
+///          given promises.
+///
+/// \since 4.3.0
+///
+template <typename... Promises>
+auto split_shared(Promises&&... promises) {
+  return detail::operations::shared_split_promise<
       detail::traits::unrefcv_t<Promises>...>(
       std::forward<Promises>(promises)...);
 }
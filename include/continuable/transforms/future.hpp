@@ -32,6 +32,7 @@
 #define CONTINUABLE_TRANSFORMS_FUTURE_HPP_INCLUDED
 
 #include <utility>
+#include <continuable/continuable-future.hpp>
 #include <continuable/detail/transforms/future.hpp>
 
 namespace cti {
@@ -65,6 +66,25 @@ inline auto to_future() {
         std::forward<decltype(continuable)>(continuable));
   };
 }
+
+/// Returns a transform that if applied to a continuable,
+/// it will start the continuation chain and returns the asynchronous
+/// result as cti::future.
+///
+/// In contrast to to_future no `std::promise` is involved, the result is
+/// stored inside a single allocation which is shared with the continuation.
+///
+/// \returns Returns a cti::future<Args...> which becomes ready as soon
+///          as the the continuation chain has finished, where Args are the
+///          arguments of the continuable_base.
+///
+/// \since 4.3.0
+inline auto to_cti_future() {
+  return [](auto&& continuable) {
+    return detail::transforms::to_cti_future(
+        std::forward<decltype(continuable)>(continuable));
+  };
+}
 } // namespace transforms
 /// \}
 } // namespace cti
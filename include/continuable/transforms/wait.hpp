@@ -32,10 +32,12 @@
 #define CONTINUABLE_TRANSFORMS_WAIT_HPP_INCLUDED
 
 #include <chrono>
-#include <condition_variable>
+#include <iterator>
+#include <type_traits>
 #include <utility>
 #include <continuable/detail/features.hpp>
 #include <continuable/detail/transforms/wait.hpp>
+#include <continuable/detail/traversal/range.hpp>
 
 namespace cti {
 /// \ingroup Transforms
@@ -70,6 +72,9 @@ using wait_transform_canceled_exception = detail::transforms::wait_transform_can
 /// \attention If exceptions are used, exceptions that are thrown, are rethrown
 ///            synchronously.
 ///
+/// \note The continuation is resolved into a frame on the stack of the
+///       waiting thread, hence waiting doesn't allocate.
+///
 /// \since 4.0.0
 inline auto wait() {
   return [](auto&& continuable) {
@@ -92,17 +97,16 @@ inline auto wait() {
 ///            make sure to check for a valid result value in case the
 ///            underlying time constraint timed out.
 ///
+/// \note Unlike wait, a timed wait allocates one small reference counted
+///       frame when the continuable isn't ready already, since the
+///       continuation might be resolved after the wait timed out.
+///
 /// \since 4.0.0
 template <typename Rep, typename Period>
 auto wait_for(std::chrono::duration<Rep, Period> duration) {
   return [duration](auto&& continuable) {
     return detail::transforms::wait_unsafe(
-        std::forward<decltype(continuable)>(continuable),
-        [duration](detail::transforms::condition_variable_t& cv,
-                   detail::transforms::lock_t& lock, auto&& predicate) {
-          cv.wait_for(lock, duration,
-                      std::forward<decltype(predicate)>(predicate));
-        });
+        std::forward<decltype(continuable)>(continuable), duration);
   };
 }
 
@@ -111,14 +115,99 @@ template <typename Clock, typename Duration>
 auto wait_until(std::chrono::time_point<Clock, Duration> time_point) {
   return [time_point](auto&& continuable) {
     return detail::transforms::wait_unsafe(
-        std::forward<decltype(continuable)>(continuable),
-        [time_point](detail::transforms::condition_variable_t& cv,
-                     detail::transforms::lock_t& lock, auto&& predicate) {
-          cv.wait_until(lock, time_point,
-                        std::forward<decltype(predicate)>(predicate));
-        });
+        std::forward<decltype(continuable)>(continuable), time_point);
   };
 }
+
+/// Starts all continuables of the given range at once and blocks the current
+/// thread until all of them were resolved.
+///
+/// In contrast to waiting on a cti::when_all connection, no connection is
+/// created and the waiting thread is woken up once through a single latch,
+/// after the last continuable was resolved:
+/// ```cpp
+/// std::vector<cti::continuable<int>> requests = /* ... */;
+///
+/// std::vector<cti::result<int>> results =
+///     cti::transforms::wait_all(requests.begin(), requests.end());
+/// ```
+///
+/// \param begin The begin iterator to the range of continuables,
+///              which are moved out of the range.
+///
+/// \param end   The end iterator to the range of continuables
+///
+/// \returns A `std::vector` which contains the cti::result of each
+///          continuable in the order of the range. Failures are returned
+///          through their result and aren't rethrown, a continuable which
+///          was abandoned yields an empty result.
+///
+/// \since 4.3.0
+template <
+    typename Iterator,
+    std::enable_if_t<detail::range::is_iterator<Iterator>::value>* = nullptr>
+auto wait_all(Iterator begin, Iterator end) {
+  return detail::transforms::wait_all(std::move(begin), std::move(end));
+}
+
+/// \copybrief wait_all(Iterator, Iterator)
+///
+/// \param continuables A homogeneous container such as `std::vector`
+///                     whose continuables are moved out.
+///
+/// \returns A `std::vector` which contains the cti::result of each
+///          continuable, see wait_all(Iterator, Iterator) for details.
+///
+/// \since 4.3.0
+template <typename Container,
+          std::enable_if_t<!detail::range::is_iterator<
+              std::decay_t<Container>>::value>* = nullptr>
+auto wait_all(Container&& continuables) {
+  return detail::transforms::wait_all(std::begin(continuables),
+                                      std::end(continuables));
+}
+
+/// Starts all continuables of the given range at once and blocks the current
+/// thread until the first one was resolved.
+///
+/// The remaining continuables are cancelled as described in
+/// cti::when_any_cancel and their results are dropped.
+///
+/// \param begin The begin iterator to the range of continuables,
+///              which are moved out of the range.
+///
+/// \param end   The end iterator to the range of continuables
+///
+/// \returns A `std::vector` with an entry for each continuable in the order
+///          of the range, where only the result of the first resolved
+///          continuable is present and all other results are empty.
+///          The vector is empty if the range was empty.
+///
+/// \since 4.3.0
+template <
+    typename Iterator,
+    std::enable_if_t<detail::range::is_iterator<Iterator>::value>* = nullptr>
+auto wait_any(Iterator begin, Iterator end) {
+  return detail::transforms::wait_any(std::move(begin), std::move(end));
+}
+
+/// \copybrief wait_any(Iterator, Iterator)
+///
+/// \param continuables A homogeneous container such as `std::vector`
+///                     whose continuables are moved out.
+///
+/// \returns A `std::vector` which contains the cti::result of the first
+///          resolved continuable, see wait_any(Iterator, Iterator)
+///          for details.
+///
+/// \since 4.3.0
+template <typename Container,
+          std::enable_if_t<!detail::range::is_iterator<
+              std::decay_t<Container>>::value>* = nullptr>
+auto wait_any(Container&& continuables) {
+  return detail::transforms::wait_any(std::begin(continuables),
+                                      std::end(continuables));
+}
 } // namespace transforms
 /// \}
 } // namespace cti
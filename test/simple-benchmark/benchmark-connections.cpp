@@ -0,0 +1,263 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <continuable/continuable.hpp>
+
+/// Resolves a set of promises concurrently from a fixed set of threads
+class resolver_pool {
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::size_t generation_ = 0U;
+  bool stopped_ = false;
+  std::vector<cti::promise<int>>* promises_ = nullptr;
+  std::atomic<std::size_t> pending_{0U};
+
+  void run(std::size_t index) {
+    std::size_t generation = 0U;
+    for (;;) {
+      std::vector<cti::promise<int>>* promises;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] {
+          return stopped_ || (generation_ != generation);
+        });
+        if (stopped_) {
+          return;
+        }
+        generation = generation_;
+        promises = promises_;
+      }
+
+      for (std::size_t i = index; i < promises->size(); i += threads_.size()) {
+        (*promises)[i].set_value(int(i));
+      }
+
+      pending_.fetch_sub(1U, std::memory_order_release);
+    }
+  }
+
+public:
+  explicit resolver_pool(std::size_t threads) {
+    for (std::size_t i = 0U; i < threads; ++i) {
+      threads_.emplace_back([this, i] {
+        run(i);
+      });
+    }
+  }
+
+  ~resolver_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  void resolve(std::vector<cti::promise<int>>& promises) {
+    pending_.store(threads_.size(), std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      promises_ = &promises;
+      ++generation_;
+    }
+    cv_.notify_all();
+
+    while (pending_.load(std::memory_order_acquire) != 0U) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+/// The std::shared_ptr and std::call_once based submitter which finished
+/// when_all before it was reduced to a single atomic state word,
+/// used as baseline.
+class legacy_all_submitter
+    : public std::enable_shared_from_this<legacy_all_submitter> {
+  cti::promise<std::vector<int>> promise_;
+  std::vector<int> results_;
+  std::atomic<std::size_t> left_{1U};
+  std::once_flag flag_;
+
+  void complete_one() {
+    if (!--left_) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      std::call_once(flag_, [&] {
+        promise_.set_value(std::move(results_));
+      });
+    }
+  }
+
+  struct partial_callback {
+    std::size_t index;
+    std::shared_ptr<legacy_all_submitter> me;
+
+    void operator()(int value) && {
+      me->results_[index] = value;
+      me->complete_one();
+    }
+    void operator()(cti::exception_arg_t, cti::exception_t exception) && {
+      std::call_once(me->flag_, [&] {
+        me->promise_.set_exception(std::move(exception));
+      });
+    }
+  };
+
+public:
+  legacy_all_submitter(cti::promise<std::vector<int>> promise,
+                       std::size_t count)
+      : promise_(std::move(promise)), results_(count) {
+  }
+
+  auto create_callback(std::size_t index) {
+    left_.fetch_add(1, std::memory_order_seq_cst);
+    return partial_callback{index, shared_from_this()};
+  }
+
+  void accept() {
+    complete_one();
+  }
+};
+
+/// The std::shared_ptr and std::call_once based submitter which finished
+/// when_any before it was reduced to a single atomic state word,
+/// used as baseline.
+class legacy_any_submitter
+    : public std::enable_shared_from_this<legacy_any_submitter> {
+  cti::promise<int> promise_;
+  std::once_flag flag_;
+
+  struct any_callback {
+    std::shared_ptr<legacy_any_submitter> me;
+
+    template <typename... Args>
+    void operator()(Args&&... args) && {
+      std::call_once(me->flag_, [&] {
+        std::move(me->promise_)(std::forward<Args>(args)...);
+      });
+    }
+  };
+
+public:
+  explicit legacy_any_submitter(cti::promise<int> promise)
+      : promise_(std::move(promise)) {
+  }
+
+  auto create_callback() {
+    return any_callback{shared_from_this()};
+  }
+};
+
+static cti::continuable<std::vector<int>>
+legacy_when_all(std::vector<cti::continuable<int>> continuables) {
+  return cti::make_continuable<std::vector<int>>(
+      [continuables = std::move(continuables)](auto&& promise) mutable {
+        auto submitter = std::make_shared<legacy_all_submitter>(
+            std::forward<decltype(promise)>(promise), continuables.size());
+        for (std::size_t i = 0U; i < continuables.size(); ++i) {
+          std::move(continuables[i])
+              .next(submitter->create_callback(i))
+              .done();
+        }
+        submitter->accept();
+      });
+}
+
+static cti::continuable<int>
+legacy_when_any(std::vector<cti::continuable<int>> continuables) {
+  return cti::make_continuable<int>(
+      [continuables = std::move(continuables)](auto&& promise) mutable {
+        auto submitter = std::make_shared<legacy_any_submitter>(
+            std::forward<decltype(promise)>(promise));
+        for (auto& continuable : continuables) {
+          std::move(continuable).next(submitter->create_callback()).done();
+        }
+      });
+}
+
+template <typename Connector>
+static void bm_connection_concurrent(benchmark::State& state,
+                                     Connector&& connector) {
+  auto const threads = std::size_t(state.range(0));
+  auto const children = threads * 8U;
+
+  resolver_pool pool(threads);
+  std::vector<cti::promise<int>> promises(children);
+
+  for (auto _ : state) {
+    std::vector<cti::continuable<int>> continuables;
+    continuables.reserve(children);
+    for (auto& promise : promises) {
+      continuables.push_back(
+          cti::make_continuable<int>([slot = &promise](auto&& promise) {
+            *slot = std::forward<decltype(promise)>(promise);
+          }));
+    }
+
+    std::atomic<bool> finished(false);
+    connector(std::move(continuables)).then([&](auto&&...) {
+      finished.store(true, std::memory_order_release);
+    });
+
+    pool.resolve(promises);
+
+    while (!finished.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * std::int64_t(children));
+}
+
+static void bm_when_all_concurrent(benchmark::State& state) {
+  bm_connection_concurrent(state, [](auto&& continuables) {
+    return cti::when_all(std::forward<decltype(continuables)>(continuables));
+  });
+}
+
+static void bm_legacy_when_all_concurrent(benchmark::State& state) {
+  bm_connection_concurrent(state, [](auto&& continuables) {
+    return legacy_when_all(std::forward<decltype(continuables)>(continuables));
+  });
+}
+
+static void bm_when_any_concurrent(benchmark::State& state) {
+  bm_connection_concurrent(state, [](auto&& continuables) {
+    return cti::when_any(std::forward<decltype(continuables)>(continuables));
+  });
+}
+
+static void bm_legacy_when_any_concurrent(benchmark::State& state) {
+  bm_connection_concurrent(state, [](auto&& continuables) {
+    return legacy_when_any(std::forward<decltype(continuables)>(continuables));
+  });
+}
+
+// Resolves 8 children per thread concurrently on up to 32 threads
+BENCHMARK(bm_legacy_when_all_concurrent)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+BENCHMARK(bm_when_all_concurrent)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+BENCHMARK(bm_legacy_when_any_concurrent)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+BENCHMARK(bm_when_any_concurrent)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
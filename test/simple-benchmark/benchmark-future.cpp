@@ -0,0 +1,62 @@
+#include <future>
+#include <benchmark/benchmark.h>
+#include <boost/thread/future.hpp>
+#include <continuable/continuable.hpp>
+
+static auto do_sth_continuable() {
+  return cti::make_continuable<int>([](auto&& promise) {
+    promise.set_value(1);
+  });
+}
+
+/// Resolves a std::future through transforms::to_future
+static void bm_std_future(benchmark::State& state) {
+  for (auto _ : state) {
+    std::future<int> future =
+        do_sth_continuable().apply(cti::transforms::to_future());
+    benchmark::DoNotOptimize(future.get());
+  }
+}
+
+/// Resolves a cti::future through transforms::to_cti_future
+static void bm_cti_future(benchmark::State& state) {
+  for (auto _ : state) {
+    cti::future<int> future =
+        do_sth_continuable().apply(cti::transforms::to_cti_future());
+    benchmark::DoNotOptimize(future.get());
+  }
+}
+
+/// Resolves a boost::future through its promise directly
+static void bm_boost_future(benchmark::State& state) {
+  for (auto _ : state) {
+    boost::promise<int> promise;
+    boost::future<int> future = promise.get_future();
+    promise.set_value(1);
+    benchmark::DoNotOptimize(future.get());
+  }
+}
+
+/// Polls a cti::future which is resolved on another thread
+static void bm_cti_future_polling(benchmark::State& state) {
+  cti::thread_pool pool(1);
+
+  for (auto _ : state) {
+    cti::future<int> future = cti::async_on(
+                                  [] {
+                                    return 1;
+                                  },
+                                  pool.executor())
+                                  .apply(cti::transforms::to_cti_future());
+    while (!future.is_ready()) {
+    }
+    benchmark::DoNotOptimize(future.get());
+  }
+}
+
+BENCHMARK(bm_std_future);
+BENCHMARK(bm_cti_future);
+BENCHMARK(bm_boost_future);
+BENCHMARK(bm_cti_future_polling)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <benchmark/benchmark.h>
+#include <continuable/continuable.hpp>
+
+/// The recursive loop_frame which drove cti::loop before synchronously
+/// completing iterations were started from a plain loop, used as baseline.
+///
+/// Every ready iteration recurses once, hence it's only measured for
+/// short loops which don't overflow the stack.
+template <typename Callable>
+class legacy_loop_frame
+    : public cti::detail::util::ref_counted<legacy_loop_frame<Callable>> {
+  cti::promise<> promise_;
+  Callable callable_;
+
+public:
+  legacy_loop_frame(cti::promise<> promise, Callable callable)
+      : promise_(std::move(promise)), callable_(std::move(callable)) {
+  }
+
+  void loop() {
+    auto me = cti::detail::util::ref_of(this);
+    callable_().next([me = std::move(me)](auto&&... args) {
+      me->resolve(std::forward<decltype(args)>(args)...);
+    });
+  }
+
+  void resolve(cti::result<> result) {
+    if (result.is_empty()) {
+      loop();
+    } else if (result.is_value()) {
+      promise_.set_value();
+    } else {
+      promise_.set_exception(std::move(result).get_exception());
+    }
+  }
+
+  void resolve(cti::exception_arg_t, cti::exception_t exception) {
+    promise_.set_exception(std::move(exception));
+  }
+};
+
+template <typename Callable>
+static cti::continuable<> legacy_loop(Callable callable) {
+  return cti::make_continuable<void>(
+      [callable = std::move(callable)](auto&& promise) mutable {
+        auto frame = cti::detail::util::make_ref<legacy_loop_frame<Callable>>(
+            std::forward<decltype(promise)>(promise), std::move(callable));
+        frame->loop();
+      });
+}
+
+/// Runs loops whose iterations complete synchronously
+template <typename Looper>
+static void bm_loop_ready(benchmark::State& state, Looper&& looper) {
+  auto const iterations = std::size_t(state.range(0));
+
+  for (auto _ : state) {
+    std::size_t i = 0U;
+    looper([&]() -> cti::continuable<cti::result<>> {
+      if (++i == iterations) {
+        return cti::make_ready_continuable(cti::make_result());
+      } else {
+        return cti::make_ready_continuable(cti::result<>::empty());
+      }
+    }).then([&] {
+      benchmark::DoNotOptimize(i);
+    });
+  }
+
+  state.SetItemsProcessed(state.iterations() * std::int64_t(iterations));
+}
+
+static void bm_loop_ready(benchmark::State& state) {
+  bm_loop_ready(state, [](auto&& callable) {
+    return cti::loop(std::forward<decltype(callable)>(callable));
+  });
+}
+
+static void bm_legacy_loop_ready(benchmark::State& state) {
+  bm_loop_ready(state, [](auto&& callable) {
+    return legacy_loop(std::forward<decltype(callable)>(callable));
+  });
+}
+
+/// Runs range loops whose iterations complete synchronously
+static void bm_range_loop_ready(benchmark::State& state) {
+  auto const iterations = int(state.range(0));
+
+  for (auto _ : state) {
+    int sum = 0;
+    cti::range_loop(
+        [&](int current) {
+          sum += current;
+          return cti::make_ready_continuable();
+        },
+        0, iterations)
+        .then([&] {
+          benchmark::DoNotOptimize(sum);
+        });
+  }
+
+  state.SetItemsProcessed(state.iterations() * std::int64_t(iterations));
+}
+
+// Short loops shouldn't pay for the constant stack depth of long ones
+BENCHMARK(bm_loop_ready)->RangeMultiplier(8)->Range(1, 1 << 15);
+BENCHMARK(bm_legacy_loop_ready)->RangeMultiplier(8)->Range(1, 1 << 9);
+BENCHMARK(bm_range_loop_ready)->RangeMultiplier(8)->Range(1, 1 << 15);
+
+BENCHMARK_MAIN();
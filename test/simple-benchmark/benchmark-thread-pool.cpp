@@ -0,0 +1,125 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <continuable/continuable.hpp>
+
+/// A naive thread pool which shares a single locked queue between all threads
+class shared_queue_pool {
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<cti::work> queue_;
+  bool stopped_ = false;
+
+  void run() {
+    for (;;) {
+      cti::work work;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] {
+          return stopped_ || !queue_.empty();
+        });
+        if (queue_.empty()) {
+          return;
+        }
+        work = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      std::move(work)();
+    }
+  }
+
+public:
+  explicit shared_queue_pool(std::size_t threads) {
+    for (std::size_t i = 0U; i < threads; ++i) {
+      threads_.emplace_back([this] {
+        run();
+      });
+    }
+  }
+
+  ~shared_queue_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  void post(cti::work work) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(work));
+    }
+    cv_.notify_one();
+  }
+
+  auto executor() {
+    return [this](cti::work work) {
+      post(std::move(work));
+    };
+  }
+};
+
+/// Runs 4 chains of 64 chained continuations per thread concurrently
+template <typename Pool>
+static void bm_chained_continuations(benchmark::State& state) {
+  auto const threads = std::size_t(state.range(0));
+  auto const chains = threads * 4U;
+  constexpr std::size_t length = 64U;
+
+  Pool pool(threads);
+
+  for (auto _ : state) {
+    std::atomic<std::size_t> pending(chains);
+
+    for (std::size_t i = 0U; i < chains; ++i) {
+      cti::continuable<std::size_t> chain = cti::async_on(
+          [] {
+            return std::size_t(0U);
+          },
+          pool.executor());
+
+      for (std::size_t step = 0U; step < length; ++step) {
+        chain = std::move(chain).then(
+            [](std::size_t value) {
+              return value + 1U;
+            },
+            pool.executor());
+      }
+
+      std::move(chain).then([&](std::size_t value) {
+        benchmark::DoNotOptimize(value);
+        pending.fetch_sub(1U, std::memory_order_release);
+      });
+    }
+
+    while (pending.load(std::memory_order_acquire) != 0U) {
+      std::this_thread::yield();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() *
+                          std::int64_t(chains * (length + 1U)));
+}
+
+BENCHMARK_TEMPLATE(bm_chained_continuations, shared_queue_pool)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(bm_chained_continuations, cti::thread_pool)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
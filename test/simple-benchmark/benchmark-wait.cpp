@@ -0,0 +1,45 @@
+#include <chrono>
+#include <benchmark/benchmark.h>
+#include <continuable/continuable.hpp>
+
+/// Waits for continuables which are resolved synchronously on the waiting
+/// thread but aren't ready continuables, hence they require a wait frame.
+static void bm_wait_inline(benchmark::State& state) {
+  for (auto _ : state) {
+    auto const value = cti::make_continuable<int>([](auto&& promise) {
+                        promise.set_value(1);
+                      }).apply(cti::transforms::wait());
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+/// Waits for continuables which are resolved synchronously with a timeout
+static void bm_wait_for_inline(benchmark::State& state) {
+  for (auto _ : state) {
+    auto value = cti::make_continuable<int>([](auto&& promise) {
+                   promise.set_value(1);
+                 }).apply(cti::transforms::wait_for(std::chrono::seconds(1)));
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+/// Waits for continuables which are resolved on a thread pool
+static void bm_wait_pool(benchmark::State& state) {
+  cti::thread_pool pool(1);
+
+  for (auto _ : state) {
+    auto const value = cti::async_on(
+                          [] {
+                            return 1;
+                          },
+                          pool.executor())
+                          .apply(cti::transforms::wait());
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+BENCHMARK(bm_wait_inline);
+BENCHMARK(bm_wait_for_inline);
+BENCHMARK(bm_wait_pool)->UseRealTime();
+
+BENCHMARK_MAIN();
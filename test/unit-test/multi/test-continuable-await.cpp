@@ -31,7 +31,11 @@
 #    include <exception>
 #  endif // CONTINUABLE_WITH_NO_EXCEPTIONS
 
+#  include <cstddef>
+#  include <memory>
+#  include <thread>
 #  include <tuple>
+#  include <vector>
 
 /// Resolves the given promise asynchonously
 template <typename S>
@@ -77,6 +81,355 @@ TYPED_TEST(single_dimension_tests, are_awaitable) {
   EXPECT_ASYNC_RESULT(resolve_async_multiple(supply), 0, 1, 2, 3);
 }
 
+cti::continuable<int> resolve_nested(std::size_t depth,
+                                     cti::continuable<int>& leaf) {
+  if (depth == 0) {
+    co_return co_await std::move(leaf);
+  }
+  co_return 1 + co_await resolve_nested(depth - 1, leaf);
+}
+
+TEST(await_symmetric_transfer, resumes_nested_coroutines) {
+  cti::promise<int> resolver;
+  cti::continuable<int> leaf = cti::make_continuable<int>(
+      [&](auto&& promise) {
+        resolver = std::forward<decltype(promise)>(promise);
+      });
+
+  bool resolved = false;
+  resolve_nested(1000, leaf).then([&](int value) {
+    EXPECT_EQ(value, 1042);
+    resolved = true;
+  });
+
+  ASSERT_FALSE(resolved);
+  resolver.set_value(42);
+  ASSERT_TRUE(resolved);
+}
+
+cti::continuable<int> resolve_deferred(cti::promise<int>& resolver) {
+  co_return co_await cti::make_continuable<int>([&](auto&& promise) {
+    resolver = std::forward<decltype(promise)>(promise);
+  });
+}
+
+TEST(await_symmetric_transfer, resumes_coroutines_resolved_by_handlers) {
+  cti::promise<int> first;
+  cti::promise<int> second;
+
+  bool resumed = false;
+  resolve_deferred(second).then([&](int value) {
+    EXPECT_EQ(value, 2);
+    resumed = true;
+  });
+
+  bool handled = false;
+  resolve_deferred(first).then([&](int value) {
+    EXPECT_EQ(value, 1);
+    // The coroutine which awaits the second promise is resumed
+    // before the promise returns, also inside of this handler.
+    second.set_value(2);
+    EXPECT_TRUE(resumed);
+    handled = true;
+  });
+
+  first.set_value(1);
+  ASSERT_TRUE(handled);
+  ASSERT_TRUE(resumed);
+}
+
+template <typename S>
+cti::task<int> resolve_task_one(S&& supplier) {
+  co_await supplier();
+  co_return co_await supplier(4644);
+}
+
+template <typename S>
+cti::task<int, int> resolve_task_multiple(S&& supplier) {
+  co_return co_await supplier(1, 2);
+}
+
+template <typename S>
+cti::task<> resolve_task(S&& supplier) {
+  // Tasks are awaited without a conversion
+  int a1 = co_await resolve_task_one(supplier);
+  EXPECT_EQ(a1, 4644);
+
+  std::tuple<int, int> a2 = co_await resolve_task_multiple(supplier);
+  EXPECT_EQ(a2, std::make_tuple(1, 2));
+}
+
+TYPED_TEST(single_dimension_tests, are_awaitable_as_task) {
+  auto const supply = [&](auto&&... args) {
+    return this->supply(std::forward<decltype(args)>(args)...);
+  };
+
+  EXPECT_ASYNC_RESULT(resolve_task(supply).to_continuable());
+  EXPECT_ASYNC_RESULT(resolve_task_one(supply).to_continuable(), 4644);
+  EXPECT_ASYNC_RESULT(resolve_task_multiple(supply).to_continuable(), 1, 2);
+}
+
+cti::task<int> resolve_nested_task(std::size_t depth, bool& started) {
+  started = true;
+  if (depth == 0) {
+    co_return 0;
+  }
+  co_return 1 + co_await resolve_nested_task(depth - 1, started);
+}
+
+TEST(await_task, is_started_lazily) {
+  bool started = false;
+  cti::task<int> task = resolve_nested_task(0, started);
+  ASSERT_FALSE(started);
+
+  cti::continuable<int> continuable = std::move(task).to_continuable();
+  ASSERT_FALSE(task.is_valid());
+  ASSERT_FALSE(started);
+
+  EXPECT_ASYNC_RESULT(std::move(continuable), 0);
+  ASSERT_TRUE(started);
+}
+
+TEST(await_task, resumes_nested_tasks) {
+  bool started = false;
+  EXPECT_ASYNC_RESULT(resolve_nested_task(1000, started).to_continuable(),
+                      1000);
+}
+
+TEST(await_task, is_destroyed_when_not_started) {
+  bool started = false;
+  {
+    cti::task<int> task = resolve_nested_task(0, started);
+    cti::task<int> other = std::move(task);
+    task = std::move(other);
+    ASSERT_TRUE(task.is_valid());
+  }
+  ASSERT_FALSE(started);
+}
+
+template <typename Executor>
+cti::continuable<int> resolve_resumed_on(Executor executor) {
+  co_await cti::resume_on(executor);
+  co_return 1;
+}
+
+TEST(await_resume_on, resumes_through_the_executor) {
+  std::vector<cti::work> queue;
+  auto executor = [&](auto&& work) {
+    queue.emplace_back(std::forward<decltype(work)>(work));
+  };
+
+  bool resolved = false;
+  resolve_resumed_on(executor).then([&](int value) {
+    EXPECT_EQ(value, 1);
+    resolved = true;
+  });
+
+  ASSERT_FALSE(resolved);
+  ASSERT_EQ(queue.size(), 1U);
+  std::move(queue.front())();
+  ASSERT_TRUE(resolved);
+}
+
+cti::continuable<std::thread::id> resolve_thread_id(cti::thread_pool& pool) {
+  co_await cti::resume_on(pool.executor());
+  co_return std::this_thread::get_id();
+}
+
+TEST(await_resume_on, resumes_on_the_thread_of_the_executor) {
+  cti::thread_pool pool(1);
+  std::thread::id id =
+      value_of(resolve_thread_id(pool).apply(cti::transforms::wait()));
+  EXPECT_NE(id, std::this_thread::get_id());
+}
+
+template <typename S>
+cti::continuable<int> resolve_connection(S&& supplier) {
+  auto [a, b] = co_await (supplier(1) && supplier(2));
+  EXPECT_EQ(a, 1);
+  EXPECT_EQ(b, 2);
+
+  std::tuple<int, int, int> all =
+      co_await cti::when_all(supplier(1), supplier(2, 3));
+  EXPECT_EQ(all, std::make_tuple(1, 2, 3));
+
+  co_await (supplier() && supplier());
+
+  co_return a + b;
+}
+
+TYPED_TEST(single_dimension_tests, are_awaitable_as_connection) {
+  auto const supply = [&](auto&&... args) {
+    return this->supply(std::forward<decltype(args)>(args)...);
+  };
+
+  EXPECT_ASYNC_RESULT(resolve_connection(supply), 3);
+}
+
+cti::continuable<int> resolve_deferred_connection(cti::promise<int>& left,
+                                                  cti::promise<int>& right) {
+  auto [a, b] = co_await (cti::make_continuable<int>([&](auto&& promise) {
+                            left = std::forward<decltype(promise)>(promise);
+                          }) &&
+                          cti::make_continuable<int>([&](auto&& promise) {
+                            right = std::forward<decltype(promise)>(promise);
+                          }));
+  co_return a + b;
+}
+
+TEST(await_connection, resumes_when_all_continuations_settled) {
+  cti::promise<int> left;
+  cti::promise<int> right;
+
+  bool resolved = false;
+  resolve_deferred_connection(left, right).then([&](int value) {
+    EXPECT_EQ(value, 3);
+    resolved = true;
+  });
+
+  right.set_value(2);
+  ASSERT_FALSE(resolved);
+  left.set_value(1);
+  ASSERT_TRUE(resolved);
+}
+
+#  ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
+TEST(await_connection, resumes_with_the_first_error) {
+  cti::promise<int> left;
+  cti::promise<int> right;
+
+  bool failed = false;
+  resolve_deferred_connection(left, right)
+      .then([](int) {
+        FAIL();
+      })
+      .fail([&](cti::exception_t) {
+        failed = true;
+      });
+
+  left.set_exception(supply_test_exception());
+  // The coroutine is resumed on the first error
+  ASSERT_TRUE(failed);
+  // The remaining continuation is settled afterwards
+  right.set_value(2);
+}
+
+TEST(await_connection, resumes_once_on_multiple_errors) {
+  cti::promise<int> left;
+  cti::promise<int> right;
+
+  int failed = 0;
+  resolve_deferred_connection(left, right)
+      .then([](int) {
+        FAIL();
+      })
+      .fail([&](cti::exception_t) {
+        ++failed;
+      });
+
+  right.set_exception(supply_test_exception());
+  left.set_exception(supply_test_exception());
+  ASSERT_EQ(failed, 1);
+}
+#  endif // CONTINUABLE_WITH_NO_EXCEPTIONS
+
+template <typename T>
+struct counting_allocator {
+  using value_type = T;
+
+  std::size_t* allocations;
+
+  explicit counting_allocator(std::size_t* allocations)
+    : allocations(allocations) {}
+  template <typename O>
+  counting_allocator(counting_allocator<O> const& other) noexcept
+    : allocations(other.allocations) {}
+
+  T* allocate(std::size_t count) {
+    ++*allocations;
+    return std::allocator<T>{}.allocate(count);
+  }
+  void deallocate(T* ptr, std::size_t count) noexcept {
+    --*allocations;
+    std::allocator<T>{}.deallocate(ptr, count);
+  }
+};
+
+template <typename S>
+cti::continuable<int> resolve_allocated(std::allocator_arg_t,
+                                        counting_allocator<int> allocator,
+                                        S&& supplier) {
+  EXPECT_EQ(*allocator.allocations, 1U);
+  co_await supplier();
+  co_return 4644;
+}
+
+TYPED_TEST(single_dimension_tests, are_allocated_through_allocators) {
+  auto const supply = [&](auto&&... args) {
+    return this->supply(std::forward<decltype(args)>(args)...);
+  };
+
+  std::size_t allocations = 0;
+  EXPECT_ASYNC_RESULT(resolve_allocated(std::allocator_arg,
+                                        counting_allocator<int>(&allocations),
+                                        supply),
+                      4644);
+  ASSERT_EQ(allocations, 0U);
+}
+
+TEST(await_frame_pool, reuses_released_frames) {
+  using namespace cti::detail::awaiting;
+
+  void* first = allocate_frame(200);
+  deallocate_frame(first, 200);
+
+  // The frame is reused for frames of the same size class
+  void* second = allocate_frame(190);
+  EXPECT_EQ(first, second);
+  deallocate_frame(second, 190);
+
+  // Frames of up to 1 KiB including their bookkeeping are pooled
+  std::size_t const largest = frame_granularity * frame_classes -
+                              sizeof(frame_deallocator);
+  void* third = allocate_frame(largest);
+  deallocate_frame(third, largest);
+  void* fourth = allocate_frame(largest - 8U);
+  EXPECT_EQ(third, fourth);
+  deallocate_frame(fourth, largest - 8U);
+
+  // Frames exceeding the largest size class aren't served from the pool
+  std::size_t const large = frame_granularity * frame_classes;
+  void* fifth = allocate_frame(large);
+  EXPECT_NE(fourth, fifth);
+  deallocate_frame(fifth, large);
+}
+
+template <typename S>
+cti::continuable<int> resolve_as_result(S&& supplier) {
+  cti::result<int> value = co_await cti::as_result(supplier(1));
+  EXPECT_TRUE(value.is_value());
+
+  cti::result<int> failed = co_await cti::as_result(
+      cti::make_exceptional_continuable<int>(supply_test_exception()));
+  EXPECT_TRUE(failed.is_exception());
+  EXPECT_TRUE(bool(failed.get_exception()));
+
+  cti::result<> canceled =
+      co_await cti::as_result(cti::make_cancelling_continuable<void>());
+  EXPECT_TRUE(canceled.is_exception());
+  EXPECT_FALSE(bool(canceled.get_exception()));
+
+  co_return *value + 1;
+}
+
+TYPED_TEST(single_dimension_tests, are_awaitable_as_result) {
+  auto const supply = [&](auto&&... args) {
+    return this->supply(std::forward<decltype(args)>(args)...);
+  };
+
+  EXPECT_ASYNC_RESULT(resolve_as_result(supply), 2);
+}
+
 #  ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
 
 struct await_exception : std::exception {
@@ -169,6 +522,29 @@ TYPED_TEST(single_dimension_tests, are_awaitable_with_cancellation_from_coro) {
   ASSERT_ASYNC_CANCELLATION(resolve_coro_canceled(supply))
 }
 
+TEST(await_resume_on, is_canceled_when_the_work_is_dropped) {
+  auto executor = [](auto&& work) {
+    (void)work;
+  };
+
+  ASSERT_ASYNC_CANCELLATION(resolve_resumed_on(executor))
+}
+
+cti::task<> resolve_task_exceptional() {
+  throw await_exception{};
+  co_return;
+}
+
+cti::continuable<> resolve_task_rethrowing() {
+  EXPECT_THROW(co_await resolve_task_exceptional(), await_exception);
+
+  co_await resolve_task_exceptional();
+}
+
+TEST(await_task, propagates_exceptions) {
+  ASSERT_ASYNC_EXCEPTION_RESULT(resolve_task_rethrowing(), await_exception{})
+}
+
 template <typename S>
 cti::continuable<> test_symmetric_transfer(S&& supplier) {
   // If symmetric transfer is not working properly, large
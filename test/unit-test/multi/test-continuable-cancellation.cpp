@@ -0,0 +1,161 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <test-continuable.hpp>
+
+using namespace cti;
+
+TYPED_TEST(single_dimension_tests, are_not_cancelled_by_default) {
+  cancellation_source source;
+
+  EXPECT_ASYNC_RESULT(this->supply(0xDF)
+                          .then([](int value) {
+                            return value + 1;
+                          })
+                          .with_cancellation(source.token()),
+                      0xE0);
+
+  EXPECT_ASYNC_RESULT(
+      this->supply(0xDF).with_cancellation(cancellation_token{}), 0xDF);
+}
+
+TYPED_TEST(single_dimension_tests, are_cancelled_before_invocation) {
+  cancellation_source source;
+  ASSERT_TRUE(source.cancel());
+  ASSERT_FALSE(source.cancel());
+
+  ASSERT_ASYNC_CANCELLATION(this->supply(0xDF)
+                                .then([](int) {
+                                  FAIL();
+                                })
+                                .with_cancellation(source.token()));
+}
+
+TYPED_TEST(single_dimension_tests, skip_pending_callbacks_when_cancelled) {
+  cancellation_source source;
+  bool first = false;
+
+  ASSERT_ASYNC_CANCELLATION(this->supply()
+                                .then([&] {
+                                  first = true;
+                                  source.cancel();
+                                })
+                                .then([] {
+                                  FAIL();
+                                })
+                                .fail([](exception_t) {
+                                  FAIL();
+                                })
+                                .with_cancellation(source.token()));
+
+  ASSERT_TRUE(first);
+}
+
+TYPED_TEST(single_dimension_tests, observe_the_closest_token) {
+  cancellation_source inner;
+  cancellation_source outer;
+  bool called = false;
+
+  ASSERT_ASYNC_CANCELLATION(this->supply()
+                                .then([&] {
+                                  outer.cancel();
+                                })
+                                .then([&] {
+                                  called = true;
+                                })
+                                .with_cancellation(inner.token())
+                                .then([] {
+                                  FAIL();
+                                })
+                                .with_cancellation(outer.token()));
+
+  ASSERT_TRUE(called);
+}
+
+TEST(cancellation_test, is_observable_through_promises) {
+  cancellation_source source;
+  bool called = false;
+
+  ASSERT_ASYNC_CANCELLATION(make_continuable<int>([&](auto&& promise) {
+                              ASSERT_FALSE(promise.is_cancelled());
+                              source.cancel();
+                              ASSERT_TRUE(promise.is_cancelled());
+                              called = true;
+                              promise.set_value(0xDF);
+                            })
+                                .then([](int) {
+                                  FAIL();
+                                })
+                                .with_cancellation(source.token()));
+
+  ASSERT_TRUE(called);
+}
+
+TEST(cancellation_test, is_observable_through_erased_promises) {
+  cancellation_source source;
+  promise<int> stored;
+  bool cancelled = false;
+
+  continuable<int> erased = make_continuable<int>([&](promise<int> promise) {
+    stored = std::move(promise);
+  });
+
+  continuable<int> chain =
+      std::move(erased).then([](int value) { return value; });
+
+  std::move(chain)
+      .then([](int) {
+        ADD_FAILURE();
+      })
+      .with_cancellation(source.token())
+      .fail([&](exception_t exception) {
+        EXPECT_FALSE(bool(exception));
+        cancelled = true;
+      });
+
+  ASSERT_TRUE(stored);
+  ASSERT_FALSE(stored.is_cancelled());
+  source.cancel();
+  ASSERT_TRUE(stored.is_cancelled());
+
+  stored.set_value(0xDF);
+  ASSERT_TRUE(cancelled);
+}
+
+TEST(cancellation_test, is_observable_through_connections) {
+  cancellation_source source;
+  bool observed = false;
+
+  ASSERT_ASYNC_CANCELLATION(
+      when_all(make_continuable<void>([&](auto&& promise) {
+                 source.cancel();
+                 promise.set_value();
+               }),
+               make_continuable<void>([&](auto&& promise) {
+                 observed = promise.is_cancelled();
+                 promise.set_value();
+               }))
+          .with_cancellation(source.token()));
+
+  ASSERT_TRUE(observed);
+}
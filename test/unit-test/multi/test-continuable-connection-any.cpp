@@ -81,3 +81,73 @@ TYPED_TEST(single_dimension_tests, is_logical_any_connectable) {
     EXPECT_ASYNC_RESULT(std::move(composed));
   }
 }
+
+TEST(connection_any_test, runs_the_remaining_continuables_to_completion) {
+  cti::promise<int> loser;
+  bool resolved = false;
+  bool completed = false;
+
+  cti::when_any(cti::make_continuable<int>([&](auto&& promise) {
+                  loser = std::forward<decltype(promise)>(promise);
+                }),
+                cti::make_ready_continuable(1),
+                cti::make_ready_continuable(2).then([&](int) {
+                  completed = true;
+                  return 3;
+                }))
+      .then([&](int value) {
+        EXPECT_EQ(value, 1);
+        resolved = true;
+      });
+
+  ASSERT_TRUE(resolved);
+  ASSERT_TRUE(completed);
+  ASSERT_TRUE(loser);
+  ASSERT_FALSE(loser.is_cancelled());
+  loser.set_value(4);
+}
+
+TEST(connection_any_test, cancels_the_remaining_continuables_on_request) {
+  cti::promise<int> loser;
+  bool resolved = false;
+
+  cti::when_any_cancel(cti::make_continuable<int>([&](auto&& promise) {
+                         loser = std::forward<decltype(promise)>(promise);
+                       }),
+                       cti::make_ready_continuable(1),
+                       cti::make_ready_continuable(2).then([](int) {
+                         ADD_FAILURE();
+                         return 3;
+                       }))
+      .then([&](int value) {
+        EXPECT_EQ(value, 1);
+        resolved = true;
+      });
+
+  ASSERT_TRUE(resolved);
+  ASSERT_TRUE(loser);
+  ASSERT_TRUE(loser.is_cancelled());
+  loser.set_value(4);
+}
+
+TEST(connection_any_test, forwards_the_cancellation_of_the_chain) {
+  cti::cancellation_source source;
+  cti::promise<int> left;
+  cti::promise<int> right;
+
+  (cti::make_continuable<int>([&](auto&& promise) {
+     left = std::forward<decltype(promise)>(promise);
+   }) ||
+   cti::make_continuable<int>([&](auto&& promise) {
+     right = std::forward<decltype(promise)>(promise);
+   }))
+      .with_cancellation(source.token())
+      .fail([](cti::exception_t) {});
+
+  ASSERT_FALSE(left.is_cancelled());
+  ASSERT_FALSE(right.is_cancelled());
+  source.cancel();
+  ASSERT_TRUE(left.is_cancelled());
+  ASSERT_TRUE(right.is_cancelled());
+  left.set_canceled();
+}
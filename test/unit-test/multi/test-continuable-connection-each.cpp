@@ -0,0 +1,132 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <vector>
+
+#include <test-continuable.hpp>
+
+TYPED_TEST(single_dimension_tests, is_each_connectable) {
+  {
+    std::vector<int> handled;
+    auto chain = cti::when_each(
+        cti::populate(this->supply(1), this->supply(2), this->supply(3)),
+        [&](int value) {
+          handled.push_back(value);
+        });
+
+    ASSERT_ASYNC_COMPLETION(std::move(chain));
+    ASSERT_EQ(handled, (std::vector<int>{1, 2, 3}));
+  }
+
+  {
+    std::size_t handled = 0U;
+    auto continuables = cti::populate(this->supply(), this->supply());
+    auto chain = cti::when_each(continuables.begin(), continuables.end(),
+                                [&] {
+                                  ++handled;
+                                });
+
+    ASSERT_ASYNC_COMPLETION(std::move(chain));
+    ASSERT_EQ(handled, 2U);
+  }
+
+  {
+    std::vector<cti::continuable<int>> empty;
+    auto chain = cti::when_each(std::move(empty), [](int) {
+      FAIL();
+    });
+
+    ASSERT_ASYNC_COMPLETION(std::move(chain));
+  }
+}
+
+TYPED_TEST(single_dimension_tests, is_each_connection_failing) {
+  std::vector<cti::continuable<int>> continuables;
+  continuables.emplace_back(this->supply(1));
+  continuables.emplace_back(
+      this->supply_exception(supply_test_exception(), identity<int>{}));
+
+  auto chain = cti::when_each(std::move(continuables), [](int value) {
+    EXPECT_EQ(value, 1);
+  });
+
+  ASSERT_ASYNC_EXCEPTION_RESULT(std::move(chain), get_test_exception_proto());
+}
+
+TEST(connection_each_test, handles_results_in_the_order_of_arrival) {
+  cti::promise<int> first;
+  cti::promise<int> second;
+  std::vector<int> handled;
+  bool resolved = false;
+
+  std::vector<cti::continuable<int>> continuables;
+  continuables.emplace_back(cti::make_continuable<int>([&](auto&& promise) {
+    first = std::forward<decltype(promise)>(promise);
+  }));
+  continuables.emplace_back(cti::make_continuable<int>([&](auto&& promise) {
+    second = std::forward<decltype(promise)>(promise);
+  }));
+
+  cti::when_each(std::move(continuables),
+                 [&](int value) {
+                   handled.push_back(value);
+                 })
+      .then([&] {
+        resolved = true;
+      });
+
+  second.set_value(2);
+  ASSERT_EQ(handled, (std::vector<int>{2}));
+  ASSERT_FALSE(resolved);
+
+  first.set_value(1);
+  ASSERT_EQ(handled, (std::vector<int>{2, 1}));
+  ASSERT_TRUE(resolved);
+}
+
+TEST(connection_each_test, cancels_the_remaining_continuables_on_failure) {
+  cti::promise<int> remaining;
+  bool failed = false;
+
+  std::vector<cti::continuable<int>> continuables;
+  continuables.emplace_back(cti::make_continuable<int>([&](auto&& promise) {
+    remaining = std::forward<decltype(promise)>(promise);
+  }));
+  continuables.emplace_back(
+      cti::make_exceptional_continuable<int>(supply_test_exception()));
+
+  cti::when_each(std::move(continuables),
+                 [](int) {
+                   ADD_FAILURE();
+                 })
+      .fail([&](cti::exception_t) {
+        failed = true;
+      });
+
+  ASSERT_TRUE(remaining.is_cancelled());
+  ASSERT_FALSE(failed);
+
+  // Results arriving after the failure aren't handled
+  remaining.set_value(1);
+  ASSERT_TRUE(failed);
+}
@@ -0,0 +1,167 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <test-continuable.hpp>
+
+#include <continuable/detail/features.hpp>
+
+#ifdef CONTINUABLE_HAS_COROUTINE
+
+#  include <cstddef>
+#  include <memory>
+#  include <utility>
+#  include <vector>
+
+template <typename S>
+cti::async_generator<int> generate_async(S supplier, int count) {
+  for (int i = 0; i < count; ++i) {
+    co_await supplier();
+    co_yield co_await supplier(i);
+  }
+}
+
+template <typename S>
+cti::continuable<int> sum_of(S supplier) {
+  auto generator = generate_async(supplier, 4);
+
+  int sum = 0;
+  for (;;) {
+    cti::result<int> current = co_await generator.next();
+    if (current.is_empty()) {
+      break;
+    }
+    sum += current.get_value();
+  }
+
+  // A finished generator stays finished
+  cti::result<int> current = co_await generator.next();
+  EXPECT_TRUE(current.is_empty());
+
+  co_return sum;
+}
+
+TYPED_TEST(single_dimension_tests, are_generating_values) {
+  auto const supply = [&](auto&&... args) {
+    return this->supply(std::forward<decltype(args)>(args)...);
+  };
+
+  EXPECT_ASYNC_RESULT(sum_of(supply), 6);
+}
+
+TYPED_TEST(single_dimension_tests, are_consumable_through_for_each) {
+  auto const supply = [&](auto&&... args) {
+    return this->supply(std::forward<decltype(args)>(args)...);
+  };
+
+  std::vector<int> values;
+  ASSERT_ASYNC_COMPLETION(
+      cti::for_each(generate_async(supply, 3), [&](int value) {
+        values.push_back(value);
+      }));
+  EXPECT_EQ(values, (std::vector<int>{0, 1, 2}));
+}
+
+cti::async_generator<int> generate_counted(int& produced) {
+  for (int i = 0; i < 3; ++i) {
+    ++produced;
+    co_yield i;
+  }
+}
+
+TEST(async_generator, is_suspended_until_the_next_value_is_requested) {
+  int produced = 0;
+  std::vector<cti::promise<>> consumed;
+
+  bool resolved = false;
+  cti::for_each(generate_counted(produced),
+                [&](int value) {
+                  EXPECT_EQ(value, produced - 1);
+                  return cti::make_continuable<void>([&](auto&& promise) {
+                    consumed.emplace_back(
+                        std::forward<decltype(promise)>(promise));
+                  });
+                })
+      .then([&] {
+        resolved = true;
+      });
+
+  ASSERT_EQ(produced, 1);
+  ASSERT_EQ(consumed.size(), 1U);
+
+  consumed[0].set_value();
+  ASSERT_EQ(produced, 2);
+  ASSERT_EQ(consumed.size(), 2U);
+
+  consumed[1].set_value();
+  consumed[2].set_value();
+  ASSERT_EQ(produced, 3);
+  ASSERT_TRUE(resolved);
+}
+
+cti::async_generator<std::shared_ptr<int>>
+generate_owning(std::shared_ptr<int> owned) {
+  co_yield owned;
+  co_yield owned;
+}
+
+cti::continuable<> consume_first(std::weak_ptr<int>& observer) {
+  auto owned = std::make_shared<int>(0);
+  observer = owned;
+
+  auto generator = generate_owning(std::move(owned));
+  cti::result<std::shared_ptr<int>> current = co_await generator.next();
+  EXPECT_TRUE(current.is_value());
+}
+
+TEST(async_generator, is_destroyed_while_suspended) {
+  std::weak_ptr<int> observer;
+  ASSERT_ASYNC_COMPLETION(consume_first(observer));
+  ASSERT_TRUE(observer.expired());
+}
+
+#  ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
+
+struct generator_exception {
+  bool operator==(generator_exception const&) const noexcept {
+    return true;
+  }
+};
+
+cti::async_generator<int> generate_exceptional() {
+  co_yield 0;
+  throw generator_exception{};
+}
+
+TEST(async_generator, propagates_exceptions_through_for_each) {
+  std::vector<int> values;
+  ASSERT_ASYNC_EXCEPTION_RESULT(cti::for_each(generate_exceptional(),
+                                              [&](int value) {
+                                                values.push_back(value);
+                                              }),
+                                generator_exception{})
+  EXPECT_EQ(values, std::vector<int>{0});
+}
+
+#  endif // CONTINUABLE_WITH_NO_EXCEPTIONS
+
+#endif // CONTINUABLE_HAS_COROUTINE
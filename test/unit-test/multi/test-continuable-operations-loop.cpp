@@ -21,6 +21,11 @@
   SOFTWARE.
 **/
 
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <sstream>
+#include <vector>
 #include <test-continuable.hpp>
 
 using namespace cti;
@@ -81,3 +86,196 @@ TYPED_TEST(single_dimension_tests, operations_loop_looping) {
 
   ASSERT_EQ(i, 3);
 }
+
+TEST(operations_loop_tests, iterates_ready_continuables_without_recursion) {
+  std::size_t i = 0U;
+
+  // Would exhaust the stack if every iteration was started recursively
+  ASSERT_ASYNC_COMPLETION(loop([&i]() -> continuable<result<>> {
+    if (++i == 100000U) {
+      return make_ready_continuable(make_result());
+    } else {
+      return make_ready_continuable(result<>::empty());
+    }
+  }));
+
+  ASSERT_EQ(i, 100000U);
+}
+
+TEST(operations_loop_tests, iterates_mixed_ready_and_deferred_continuables) {
+  std::size_t i = 0U;
+  promise<result<>> deferred;
+  bool finished = false;
+
+  loop([&]() -> continuable<result<>> {
+    ++i;
+    if (i % 10U == 0U) {
+      return make_continuable<result<>>([&](auto&& promise) {
+        deferred = std::forward<decltype(promise)>(promise);
+      });
+    } else {
+      return make_ready_continuable(result<>::empty());
+    }
+  }).then([&] {
+    finished = true;
+  });
+
+  while (deferred) {
+    // Resolving the promise starts the next iterations synchronously
+    auto current = std::move(deferred);
+    if (i == 100U) {
+      current.set_value(make_result());
+    } else {
+      current.set_value(result<>::empty());
+    }
+  }
+
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(i, 100U);
+}
+
+TEST(operations_loop_tests, releases_abandoned_deferred_iterations) {
+  auto alive = std::make_shared<int>(0);
+  promise<result<>> deferred;
+
+  loop([&deferred, alive]() -> continuable<result<>> {
+    return make_continuable<result<>>([&](auto&& promise) {
+      deferred = std::forward<decltype(promise)>(promise);
+    });
+  }).then([] {
+    FAIL();
+  });
+
+  ASSERT_TRUE(deferred);
+  ASSERT_EQ(alive.use_count(), 2);
+
+  // Dropping the promise of the suspended iteration releases the frame
+  { auto dropped = std::move(deferred); }
+  ASSERT_EQ(alive.use_count(), 1);
+}
+
+TEST(operations_loop_tests, releases_abandoned_ready_iterations) {
+  auto alive = std::make_shared<int>(0);
+
+  loop([alive]() -> continuable<result<>> {
+    return make_continuable<result<>>([](auto&&) {
+      // The promise is dropped without being resolved
+    });
+  }).then([] {
+    FAIL();
+  });
+
+  ASSERT_EQ(alive.use_count(), 1);
+}
+
+TEST(operations_loop_tests, for_each_concurrent_bounds_the_iterations) {
+  std::vector<int> visited;
+  std::deque<promise<>> running;
+  std::size_t max_running = 0U;
+  bool finished = false;
+
+  for_each_concurrent(
+      [&](int i) {
+        visited.push_back(i);
+        return make_continuable<void>([&](auto&& promise) {
+          running.push_back(std::forward<decltype(promise)>(promise));
+          max_running = std::max(max_running, running.size());
+        });
+      },
+      0, 10, 3)
+      .then([&] {
+        finished = true;
+      });
+
+  ASSERT_EQ(running.size(), 3U);
+
+  while (!running.empty()) {
+    ASSERT_FALSE(finished);
+    auto current = std::move(running.front());
+    running.pop_front();
+    current.set_value();
+  }
+
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(max_running, 3U);
+  ASSERT_EQ(visited, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(operations_loop_tests, for_each_concurrent_iterates_ready_continuables) {
+  std::size_t count = 0U;
+
+  // Would exhaust the stack if every iteration was started recursively
+  ASSERT_ASYNC_COMPLETION(for_each_concurrent(
+      [&](std::size_t) {
+        ++count;
+        return make_ready_continuable();
+      },
+      std::size_t(0U), std::size_t(100000U), 4U));
+
+  ASSERT_EQ(count, 100000U);
+}
+
+TEST(operations_loop_tests, for_each_concurrent_treats_a_zero_limit_as_one) {
+  std::size_t count = 0U;
+
+  ASSERT_ASYNC_COMPLETION(for_each_concurrent(
+      [&](std::size_t) {
+        ++count;
+        return make_ready_continuable();
+      },
+      std::size_t(0U), std::size_t(10U), 0U));
+
+  ASSERT_EQ(count, 10U);
+}
+
+TEST(operations_loop_tests, for_each_concurrent_iterates_input_ranges) {
+  std::istringstream stream("1 2 3 4 5");
+  int sum = 0;
+
+  ASSERT_ASYNC_COMPLETION(for_each_concurrent(
+      [&](std::istream_iterator<int> itr) {
+        sum += *itr;
+        return make_ready_continuable();
+      },
+      std::istream_iterator<int>(stream), std::istream_iterator<int>(), 2U));
+
+  ASSERT_EQ(sum, 15);
+}
+
+TEST(operations_loop_tests, for_each_concurrent_stops_on_failure) {
+  std::vector<int> visited;
+  std::deque<promise<>> running;
+
+  auto continuation = for_each_concurrent(
+      [&](int i) {
+        visited.push_back(i);
+        return make_continuable<void>([&](auto&& promise) {
+          running.push_back(std::forward<decltype(promise)>(promise));
+        });
+      },
+      0, 10, 2);
+
+  bool failed = false;
+  std::move(continuation)
+      .then([] {
+        FAIL();
+      })
+      .fail([&](exception_t) {
+        failed = true;
+      });
+
+  ASSERT_EQ(running.size(), 2U);
+  {
+    auto current = std::move(running.front());
+    running.pop_front();
+    current.set_exception(supply_test_exception());
+  }
+
+  // The running iteration is awaited, but no further iteration is launched
+  ASSERT_FALSE(failed);
+  ASSERT_EQ(running.size(), 1U);
+  running.front().set_value();
+
+  ASSERT_TRUE(failed);
+  ASSERT_EQ(visited, (std::vector<int>{0, 1}));
+}
@@ -0,0 +1,215 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+#include <memory>
+#include <utility>
+#include <vector>
+#include <test-continuable.hpp>
+
+using namespace cti;
+
+namespace {
+struct copy_counter {
+  std::shared_ptr<int> copies = std::make_shared<int>(0);
+
+  copy_counter() = default;
+  copy_counter(copy_counter const& other) : copies(other.copies) {
+    ++*copies;
+  }
+  copy_counter(copy_counter&&) = default;
+  copy_counter& operator=(copy_counter const&) = delete;
+  copy_counter& operator=(copy_counter&&) = default;
+};
+} // namespace
+
+TYPED_TEST(single_dimension_tests, operations_share_starts_once) {
+  int started = 0;
+  promise<int> resolver;
+
+  auto shared = this->make(identity<int>{}, identity<int>{},
+                           [&](auto&& promise) {
+                             ++started;
+                             resolver = std::forward<decltype(promise)>(
+                                 promise);
+                           })
+                    .share();
+
+  ASSERT_EQ(started, 0);
+
+  int resolved = 0;
+  for (int i = 0; i < 3; ++i) {
+    shared.then([&](int value) {
+      EXPECT_EQ(value, 42);
+      ++resolved;
+    });
+  }
+
+  ASSERT_EQ(started, 1);
+  ASSERT_FALSE(shared.is_ready());
+  ASSERT_EQ(resolved, 0);
+
+  resolver.set_value(42);
+  ASSERT_TRUE(shared.is_ready());
+  ASSERT_EQ(resolved, 3);
+}
+
+TYPED_TEST(single_dimension_tests, operations_share_caches_the_result) {
+  auto shared = this->supply(42).share();
+  auto copy = shared;
+
+  ASSERT_ASYNC_RESULT(shared.to_continuable(), 42);
+  ASSERT_TRUE(copy.is_ready());
+  ASSERT_ASYNC_RESULT(copy.then([](int value) { return value + 1; }), 43);
+  ASSERT_ASYNC_RESULT(shared.to_continuable(), 42);
+}
+
+TYPED_TEST(single_dimension_tests, operations_share_propagates_exceptions) {
+  auto shared =
+      this->supply_exception(supply_test_exception(), identity<int>{}).share();
+
+  ASSERT_ASYNC_EXCEPTION_RESULT(shared.to_continuable(),
+                                get_test_exception_proto());
+  ASSERT_ASYNC_EXCEPTION_RESULT(shared.to_continuable(),
+                                get_test_exception_proto());
+
+  bool handled = false;
+  shared
+      .fail([&](exception_t) {
+        handled = true;
+      })
+      .done();
+  ASSERT_TRUE(handled);
+}
+
+TYPED_TEST(single_dimension_tests, operations_share_is_lazy) {
+  bool started = false;
+
+  {
+    auto shared = this->make(identity<>{}, identity<void>{},
+                             [&](auto&& promise) {
+                               started = true;
+                               promise.set_value();
+                             })
+                      .share();
+    auto copy = shared;
+    (void)copy;
+  }
+
+  ASSERT_FALSE(started);
+}
+
+TYPED_TEST(single_dimension_tests, operations_share_passes_const_references) {
+  copy_counter counter;
+  auto copies = counter.copies;
+
+  promise<copy_counter> resolver;
+  auto shared = this->make(identity<copy_counter>{}, identity<copy_counter>{},
+                           [&](auto&& promise) {
+                             resolver = std::forward<decltype(promise)>(
+                                 promise);
+                           })
+                    .share();
+
+  int resolved = 0;
+  for (int i = 0; i < 2; ++i) {
+    shared.then([&](copy_counter const&) {
+      ++resolved;
+    });
+  }
+
+  resolver.set_value(std::move(counter));
+  shared.then([&](copy_counter const&) {
+    ++resolved;
+  });
+
+  ASSERT_EQ(resolved, 3);
+  // The consumers receive references to the cached result
+  ASSERT_EQ(*copies, 0);
+}
+
+TYPED_TEST(single_dimension_tests, operations_share_copies_into_consumers) {
+  copy_counter counter;
+  auto copies = counter.copies;
+
+  promise<copy_counter> resolver;
+  auto shared = this->make(identity<copy_counter>{}, identity<copy_counter>{},
+                           [&](auto&& promise) {
+                             resolver = std::forward<decltype(promise)>(
+                                 promise);
+                           })
+                    .share();
+
+  int resolved = 0;
+  shared.then([&](copy_counter) {
+    ++resolved;
+  });
+  // Callbacks which require an rvalue receive a copy of the result
+  shared.then([&](copy_counter&&) {
+    ++resolved;
+  });
+
+  resolver.set_value(std::move(counter));
+  ASSERT_EQ(resolved, 2);
+  // Every consumer receives exactly one copy of the cached result
+  ASSERT_EQ(*copies, 2);
+}
+
+TEST(operations_share, keeps_the_result_alive_for_deferred_consumers) {
+  std::vector<work> queue;
+  auto executor = [&](work task) {
+    queue.push_back(std::move(task));
+  };
+
+  int value = 0;
+  {
+    auto shared = make_ready_continuable(std::vector<int>{1, 2, 3}).share();
+    shared
+        .then(
+            [&](std::vector<int> const& values) {
+              value = values.back();
+            },
+            executor)
+        .done();
+  }
+
+  ASSERT_EQ(queue.size(), 1U);
+  std::move(queue.front())();
+  ASSERT_EQ(value, 3);
+}
+
+TEST(operations_share, cancels_consumers_when_abandoned) {
+  bool canceled = false;
+
+  auto shared = make_continuable<int>([](auto&& promise) {
+                  // The promise is dropped without being resolved
+                  (void)promise;
+                }).share();
+
+  shared
+      .next([&](auto&&... args) {
+        detail::util::unused(args...);
+        canceled = true;
+      })
+      .done();
+
+  ASSERT_TRUE(canceled);
+}
@@ -21,6 +21,8 @@
   SOFTWARE.
 **/
 
+#include <memory>
+#include <vector>
 #include <test-continuable.hpp>
 
 using namespace cti;
@@ -61,3 +63,94 @@ TYPED_TEST(single_dimension_tests, operations_split_plain_callback) {
   all.set_value();
   ASSERT_TRUE(resolved);
 }
+
+struct unique_observer {
+  int* resolved;
+
+  void operator()(std::unique_ptr<int> const& value) {
+    EXPECT_EQ(*value, 42);
+    ++*resolved;
+  }
+  void operator()(exception_arg_t, exception_t) {
+    FAIL();
+  }
+};
+
+struct mutable_observer {
+  int* resolved;
+
+  void operator()(std::unique_ptr<int>& value) {
+    EXPECT_EQ(*value, 42);
+    ++*resolved;
+  }
+  void operator()(exception_arg_t, exception_t) {
+    FAIL();
+  }
+};
+
+TYPED_TEST(single_dimension_tests, operations_split_mutable_lvalues) {
+  promise<std::unique_ptr<int>> all;
+  int resolved = 0;
+
+  all = split(std::move(all), mutable_observer{&resolved});
+  all = split(std::move(all), mutable_observer{&resolved});
+
+  all.set_value(std::make_unique<int>(42));
+  ASSERT_EQ(resolved, 2);
+}
+
+TYPED_TEST(single_dimension_tests, operations_split_as_const_move_only) {
+  promise<std::unique_ptr<int>> all;
+  int resolved = 0;
+
+  all = split_as_const(std::move(all), unique_observer{&resolved});
+  all = split_as_const(std::move(all), unique_observer{&resolved});
+
+  all.set_value(std::make_unique<int>(42));
+  ASSERT_EQ(resolved, 2);
+}
+
+TYPED_TEST(single_dimension_tests, operations_split_shared) {
+  std::vector<promise<std::shared_ptr<std::unique_ptr<int> const>>> all;
+  std::vector<std::shared_ptr<std::unique_ptr<int> const>> received;
+
+  for (int i = 0; i < 3; ++i) {
+    this->supply()
+        .then(make_continuable<std::shared_ptr<std::unique_ptr<int> const>>(
+            [&](auto&& promise) {
+              all.emplace_back(std::forward<decltype(promise)>(promise));
+            }))
+        .then([&](std::shared_ptr<std::unique_ptr<int> const> value) {
+          received.push_back(std::move(value));
+        });
+  }
+  ASSERT_EQ(all.size(), 3U);
+
+  promise<std::unique_ptr<int>> resolver = split_shared(std::move(all));
+  resolver.set_value(std::make_unique<int>(42));
+
+  ASSERT_EQ(received.size(), 3U);
+  for (auto&& value : received) {
+    // All promises share the same holder
+    ASSERT_EQ(value, received.front());
+    ASSERT_EQ(**value, 42);
+  }
+}
+
+TYPED_TEST(single_dimension_tests, operations_split_shared_exception) {
+  int failed = 0;
+
+  auto resolver = split_shared(
+      [&](auto&&... args) {
+        detail::util::unused(args...);
+        ++failed;
+      },
+      [&](auto&&... args) {
+        detail::util::unused(args...);
+        ++failed;
+      });
+
+  ASSERT_TRUE(resolver);
+  resolver.set_exception(supply_test_exception());
+  ASSERT_EQ(failed, 2);
+}
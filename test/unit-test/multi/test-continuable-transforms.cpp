@@ -71,3 +71,74 @@ TYPED_TEST(single_dimension_tests, to_future_test) {
     EXPECT_EQ(future.get(), canary);
   }
 }
+
+TYPED_TEST(single_dimension_tests, to_cti_future_test) {
+  {
+    auto future = this->supply().apply(cti::transforms::to_cti_future());
+    ASSERT_TRUE(future.is_ready());
+    future.get();
+    ASSERT_FALSE(future.valid());
+  }
+
+  {
+    auto future = this->supply(0xFD).apply(cti::transforms::to_cti_future());
+    ASSERT_TRUE(is_ready(future));
+    EXPECT_EQ(value_of(future.get()), 0xFD);
+  }
+
+  {
+    auto future =
+        this->supply(0xFD, 0xF5).apply(cti::transforms::to_cti_future());
+    ASSERT_TRUE(is_ready(future));
+    EXPECT_EQ(value_of(future.get()), std::make_tuple(0xFD, 0xF5));
+  }
+}
+
+TEST(cti_future_tests, is_resolved_asynchronously) {
+  promise<int> resolver;
+  future<int> future = make_continuable<int>([&](auto&& promise) {
+                         resolver = std::forward<decltype(promise)>(promise);
+                       }).apply(transforms::to_cti_future());
+
+  ASSERT_FALSE(future.is_ready());
+  ASSERT_EQ(future.wait_for(1ms), std::future_status::timeout);
+
+  std::thread thread([&] {
+    resolver.set_value(0xFD);
+  });
+
+  future.wait();
+  ASSERT_TRUE(future.is_ready());
+  ASSERT_EQ(value_of(future.get()), 0xFD);
+  thread.join();
+}
+
+TEST(cti_future_tests, forwards_exceptions) {
+  auto future = make_exceptional_continuable<int>(supply_test_exception())
+                    .apply(transforms::to_cti_future());
+
+  ASSERT_TRUE(future.get_result().is_exception());
+}
+
+TEST(cti_future_tests, converts_into_continuables_before_resolution) {
+  promise<int> resolver;
+  auto future = make_continuable<int>([&](auto&& promise) {
+                  resolver = std::forward<decltype(promise)>(promise);
+                }).apply(transforms::to_cti_future());
+
+  int value = 0;
+  std::move(future).to_continuable().then([&](int result) {
+    value = result;
+  });
+
+  ASSERT_EQ(value, 0);
+  resolver.set_value(0xFD);
+  ASSERT_EQ(value, 0xFD);
+}
+
+TEST(cti_future_tests, converts_into_continuables_after_resolution) {
+  auto future = make_ready_continuable(0xFD, 0xF5)
+                    .apply(transforms::to_cti_future());
+
+  ASSERT_ASYNC_RESULT(std::move(future).to_continuable(), 0xFD, 0xF5);
+}
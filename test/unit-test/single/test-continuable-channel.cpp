@@ -0,0 +1,135 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <test-continuable.hpp>
+
+TEST(channel_tests, buffers_values_up_to_its_capacity) {
+  cti::channel<int> channel(2);
+  ASSERT_EQ(channel.capacity(), 2U);
+
+  ASSERT_ASYNC_COMPLETION(channel.send(1));
+  ASSERT_ASYNC_COMPLETION(channel.send(2));
+
+  bool sent = false;
+  channel.send(3).then([&] {
+    sent = true;
+  });
+  ASSERT_FALSE(sent);
+
+  EXPECT_ASYNC_RESULT(channel.receive(), 1);
+  ASSERT_TRUE(sent);
+  EXPECT_ASYNC_RESULT(channel.receive(), 2);
+  EXPECT_ASYNC_RESULT(channel.receive(), 3);
+}
+
+TEST(channel_tests, treats_a_zero_capacity_as_one) {
+  cti::channel<int> channel(0);
+  ASSERT_EQ(channel.capacity(), 1U);
+
+  ASSERT_ASYNC_COMPLETION(channel.send(1));
+  EXPECT_ASYNC_RESULT(channel.receive(), 1);
+}
+
+TEST(channel_tests, parks_senders_while_full) {
+  cti::channel<int> channel(1);
+  ASSERT_ASYNC_COMPLETION(channel.send(0));
+
+  std::vector<int> sent;
+  for (int i = 1; i <= 3; ++i) {
+    channel.send(i).then([&sent, i] {
+      sent.push_back(i);
+    });
+  }
+  ASSERT_TRUE(sent.empty());
+
+  for (int i = 0; i <= 3; ++i) {
+    EXPECT_ASYNC_RESULT(channel.receive(), i);
+    ASSERT_EQ(sent.size(), std::size_t(i < 3 ? i + 1 : 3));
+  }
+}
+
+TEST(channel_tests, parks_receivers_while_empty) {
+  cti::channel<std::unique_ptr<int>> channel(1);
+
+  std::vector<int> received;
+  for (int i = 0; i < 3; ++i) {
+    channel.receive().then([&](std::unique_ptr<int> value) {
+      received.push_back(*value);
+    });
+  }
+  ASSERT_TRUE(received.empty());
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_ASYNC_COMPLETION(channel.send(std::make_unique<int>(i)));
+    ASSERT_EQ(received.size(), std::size_t(i + 1));
+  }
+  EXPECT_EQ(received, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(channel_tests, cancels_parked_operations_on_destruction) {
+  auto parked_receive = [] {
+    cti::channel<int> channel(1);
+    return channel.receive();
+  };
+  ASSERT_ASYNC_CANCELLATION(parked_receive());
+
+  auto parked_send = [] {
+    cti::channel<int> channel(1);
+    ASSERT_ASYNC_COMPLETION(channel.send(0));
+    return channel.send(1);
+  };
+  ASSERT_ASYNC_CANCELLATION(parked_send());
+}
+
+TEST(channel_tests, passes_values_between_threads) {
+  constexpr std::size_t threads = 4U;
+  constexpr std::size_t values = 2000U;
+
+  cti::channel<std::size_t> channel(8);
+  std::atomic<std::size_t> sum{0U};
+
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0U; i < threads; ++i) {
+    workers.emplace_back([&] {
+      for (std::size_t value = 1U; value <= values; ++value) {
+        channel.send(value).apply(cti::transforms::wait());
+      }
+    });
+    workers.emplace_back([&] {
+      for (std::size_t value = 1U; value <= values; ++value) {
+        sum += value_of(channel.receive().apply(cti::transforms::wait()));
+      }
+    });
+  }
+
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(sum.load(), threads * values * (values + 1U) / 2U);
+}
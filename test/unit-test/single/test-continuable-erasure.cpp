@@ -21,6 +21,7 @@
   SOFTWARE.
 **/
 
+#include <array>
 #include <memory>
 #include <utility>
 #include <test-continuable.hpp>
@@ -89,3 +90,140 @@ TEST(single_erasure_test, is_assignable_from_work) {
   std::move(mywork)();
   ASSERT_TRUE(flag);
 }
+
+TEST(single_erasure_test, stores_small_callbacks_inplace) {
+  int value = 0;
+  auto callback = [ptr = &value](auto&&... args) {
+    unused(std::forward<decltype(args)>(args)...);
+    ++*ptr;
+  };
+
+  static_assert(is_inplace_callback<decltype(callback)>::value,
+                "Expected the callback to be stored in place!");
+
+  promise<int> p(std::move(callback));
+  std::move(p).set_value(0);
+  ASSERT_EQ(value, 1);
+}
+
+TEST(single_erasure_test, allocates_big_callbacks) {
+  struct big_callback {
+    std::array<void*, 32> padding_;
+    int* value_;
+
+    void operator()(int) && {
+      ++*value_;
+    }
+    void operator()(exception_arg_t, exception_t) && {
+    }
+  };
+
+  static_assert(!is_inplace_callback<big_callback>::value,
+                "Expected the callback to be allocated!");
+
+  int value = 0;
+  promise<int> p(big_callback{{}, &value});
+  std::move(p).set_value(0);
+  ASSERT_EQ(value, 1);
+}
+
+TEST(single_erasure_test, stores_proxy_callbacks_inplace) {
+  int value = 0;
+  auto proxy = detail::base::callbacks::make_callback<
+      detail::identity<int>, detail::base::handle_results::yes,
+      detail::base::handle_errors::no>(
+      [ptr = &value](int result) {
+        *ptr = result;
+      },
+      detail::types::this_thread_executor_tag{},
+      detail::base::callbacks::final_callback<>{});
+
+  static_assert(is_inplace_callback<decltype(proxy)>::value,
+                "Expected the proxy callback to be stored in place!");
+
+  promise<int> p(std::move(proxy));
+  std::move(p).set_value(42);
+  ASSERT_EQ(value, 42);
+}
+
+static std::size_t allocations = 0U;
+
+template <typename T>
+struct counting_allocator {
+  using value_type = T;
+
+  counting_allocator() = default;
+  template <typename O>
+  counting_allocator(counting_allocator<O> const&) noexcept {
+  }
+
+  T* allocate(std::size_t n) {
+    ++allocations;
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) noexcept {
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  template <typename O>
+  bool operator==(counting_allocator<O> const&) const noexcept {
+    return true;
+  }
+  template <typename O>
+  bool operator!=(counting_allocator<O> const&) const noexcept {
+    return false;
+  }
+};
+
+TEST(single_erasure_test, basic_promise_uses_allocator) {
+  allocations = 0U;
+
+  std::array<void*, 32> padding{};
+  int value = 0;
+  basic_promise<counting_allocator<void>, int> p(
+      [padding, ptr = &value](auto&&... args) {
+        unused(padding, std::forward<decltype(args)>(args)...);
+        ++*ptr;
+      });
+
+  ASSERT_EQ(allocations, 1U);
+  std::move(p).set_value(0);
+  ASSERT_EQ(value, 1);
+}
+
+TEST(single_erasure_test, basic_continuable_propagates_allocator) {
+  allocations = 0U;
+
+  std::array<void*, 32> padding{};
+  basic_continuable<counting_allocator<void>, int> c =
+      make_continuable<int>([padding](auto&& promise) {
+        unused(padding);
+        promise.set_value(42);
+      });
+  ASSERT_EQ(allocations, 1U);
+
+  int value = 0;
+  std::move(c).then([padding, ptr = &value](int result) {
+    unused(padding);
+    *ptr = result;
+  });
+
+  ASSERT_EQ(allocations, 2U);
+  ASSERT_EQ(value, 42);
+}
+
+TEST(single_erasure_test, basic_work_uses_allocator) {
+  allocations = 0U;
+
+  std::array<void*, 32> padding{};
+  bool flag = false;
+  basic_work<counting_allocator<void>> mywork(
+      [padding, &flag](auto&&... args) {
+        unused(padding, std::forward<decltype(args)>(args)...);
+        flag = true;
+      });
+
+  ASSERT_EQ(allocations, 1U);
+  std::move(mywork)();
+  ASSERT_TRUE(flag);
+}
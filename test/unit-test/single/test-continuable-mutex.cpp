@@ -0,0 +1,393 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <test-continuable.hpp>
+
+using cti::async_mutex;
+using cti::async_semaphore;
+using cti::async_shared_mutex;
+
+TEST(async_mutex_tests, is_acquired_immediately_while_unlocked) {
+  async_mutex mutex;
+
+  bool acquired = false;
+  mutex.lock().then([&](async_mutex::guard guard) {
+    ASSERT_TRUE(guard.owns_lock());
+    ASSERT_FALSE(mutex.try_lock());
+    acquired = true;
+  });
+  ASSERT_TRUE(acquired);
+
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(async_mutex_tests, resumes_waiters_in_order) {
+  async_mutex mutex;
+  async_mutex::guard owner;
+  mutex.lock().then([&](async_mutex::guard guard) {
+    owner = std::move(guard);
+  });
+  ASSERT_TRUE(owner);
+
+  std::vector<int> order;
+  std::vector<async_mutex::guard> guards;
+  guards.reserve(3);
+  for (int i = 0; i < 3; ++i) {
+    mutex.lock().then([&, i](async_mutex::guard guard) {
+      order.push_back(i);
+      guards.push_back(std::move(guard));
+    });
+  }
+  ASSERT_TRUE(order.empty());
+
+  owner.unlock();
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(order.size(), std::size_t(i + 1));
+    ASSERT_FALSE(mutex.try_lock());
+    guards.back().unlock();
+  }
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(async_mutex_tests, hands_over_to_many_synchronous_waiters) {
+  async_mutex mutex;
+  ASSERT_TRUE(mutex.try_lock());
+
+  // Every waiter releases its guard inside of its resolution,
+  // which must not recurse once per waiter.
+  std::size_t const count = 100000U;
+  std::size_t resolved = 0U;
+  for (std::size_t i = 0U; i < count; ++i) {
+    mutex.lock().then([&](async_mutex::guard) {
+      ++resolved;
+    });
+  }
+
+  mutex.unlock();
+  ASSERT_EQ(resolved, count);
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(async_mutex_tests, hands_over_other_mutexes_inline) {
+  async_mutex first;
+  async_mutex second;
+
+  async_mutex::guard second_owner;
+  second.lock().then([&](async_mutex::guard guard) {
+    second_owner = std::move(guard);
+  });
+  ASSERT_TRUE(second_owner);
+
+  bool second_resolved = false;
+  second.lock().then([&](async_mutex::guard) {
+    second_resolved = true;
+  });
+
+  ASSERT_TRUE(first.try_lock());
+  bool first_resolved = false;
+  first.lock().then([&](async_mutex::guard) {
+    // The next waiter of another mutex runs before the unlock returns
+    second_owner.unlock();
+    EXPECT_TRUE(second_resolved);
+    first_resolved = true;
+  });
+
+  first.unlock();
+  ASSERT_TRUE(first_resolved);
+  ASSERT_TRUE(second_resolved);
+}
+
+TEST(async_mutex_tests, cancels_waiters_on_destruction) {
+  auto mutex = std::make_unique<async_mutex>();
+  ASSERT_TRUE(mutex->try_lock());
+
+  bool canceled = false;
+  mutex->lock()
+      .then([](async_mutex::guard) {
+        FAIL();
+      })
+      .fail([&](cti::exception_t error) {
+        canceled = !bool(error);
+      });
+  ASSERT_FALSE(canceled);
+
+  mutex.reset();
+  ASSERT_TRUE(canceled);
+}
+
+TEST(async_mutex_tests, excludes_concurrent_owners) {
+  constexpr std::size_t threads = 4U;
+  constexpr std::size_t iterations = 2000U;
+
+  async_mutex mutex;
+  std::size_t counter = 0U;
+
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0U; i < threads; ++i) {
+    workers.emplace_back([&] {
+      for (std::size_t j = 0U; j < iterations; ++j) {
+        mutex.lock()
+            .then([&](async_mutex::guard) {
+              ++counter;
+            })
+            .apply(cti::transforms::wait());
+      }
+    });
+  }
+
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(counter, threads * iterations);
+}
+
+TEST(async_semaphore_tests, provides_its_count) {
+  async_semaphore semaphore(2);
+
+  std::vector<async_semaphore::guard> guards;
+  guards.reserve(3);
+  for (int i = 0; i < 3; ++i) {
+    semaphore.acquire().then([&](async_semaphore::guard guard) {
+      guards.push_back(std::move(guard));
+    });
+  }
+  ASSERT_EQ(guards.size(), 2U);
+  ASSERT_FALSE(semaphore.try_acquire());
+
+  guards.front().unlock();
+  ASSERT_EQ(guards.size(), 3U);
+  ASSERT_FALSE(semaphore.try_acquire());
+
+  guards.clear();
+  ASSERT_TRUE(semaphore.try_acquire());
+  ASSERT_TRUE(semaphore.try_acquire());
+  ASSERT_FALSE(semaphore.try_acquire());
+  semaphore.release();
+  semaphore.release();
+}
+
+TEST(async_semaphore_tests, hands_over_to_many_synchronous_waiters) {
+  async_semaphore semaphore(1);
+  ASSERT_TRUE(semaphore.try_acquire());
+
+  std::size_t const count = 100000U;
+  std::size_t resolved = 0U;
+  for (std::size_t i = 0U; i < count; ++i) {
+    semaphore.acquire().then([&](async_semaphore::guard) {
+      ++resolved;
+    });
+  }
+
+  semaphore.release();
+  ASSERT_EQ(resolved, count);
+  ASSERT_TRUE(semaphore.try_acquire());
+  semaphore.release();
+}
+
+TEST(async_semaphore_tests, cancels_waiters_on_destruction) {
+  auto semaphore = std::make_unique<async_semaphore>(0);
+
+  bool canceled = false;
+  semaphore->acquire()
+      .then([](async_semaphore::guard) {
+        FAIL();
+      })
+      .fail([&](cti::exception_t error) {
+        canceled = !bool(error);
+      });
+  ASSERT_FALSE(canceled);
+
+  semaphore.reset();
+  ASSERT_TRUE(canceled);
+}
+
+TEST(async_semaphore_tests, limits_concurrent_owners) {
+  constexpr std::size_t threads = 4U;
+  constexpr std::size_t iterations = 2000U;
+  constexpr std::size_t count = 2U;
+
+  async_semaphore semaphore(count);
+  std::atomic<std::size_t> owners{0U};
+  std::atomic<std::size_t> acquisitions{0U};
+
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0U; i < threads; ++i) {
+    workers.emplace_back([&] {
+      for (std::size_t j = 0U; j < iterations; ++j) {
+        semaphore.acquire()
+            .then([&](async_semaphore::guard) {
+              EXPECT_LE(++owners, count);
+              ++acquisitions;
+              --owners;
+            })
+            .apply(cti::transforms::wait());
+      }
+    });
+  }
+
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(acquisitions.load(), threads * iterations);
+}
+
+TEST(async_shared_mutex_tests, shares_the_ownership_between_readers) {
+  async_shared_mutex mutex;
+
+  std::vector<async_shared_mutex::shared_guard> readers;
+  for (int i = 0; i < 2; ++i) {
+    mutex.lock_shared().then([&](async_shared_mutex::shared_guard guard) {
+      readers.push_back(std::move(guard));
+    });
+  }
+  ASSERT_EQ(readers.size(), 2U);
+  ASSERT_FALSE(mutex.try_lock());
+
+  readers.clear();
+  ASSERT_TRUE(mutex.try_lock());
+  ASSERT_FALSE(mutex.try_lock_shared());
+  mutex.unlock();
+}
+
+TEST(async_shared_mutex_tests, queued_writers_exclude_later_readers) {
+  async_shared_mutex mutex;
+
+  async_shared_mutex::shared_guard reader;
+  mutex.lock_shared().then([&](async_shared_mutex::shared_guard guard) {
+    reader = std::move(guard);
+  });
+  ASSERT_TRUE(reader);
+
+  std::vector<int> order;
+  async_shared_mutex::guard writer;
+  std::vector<async_shared_mutex::shared_guard> readers;
+  mutex.lock().then([&](async_shared_mutex::guard guard) {
+    order.push_back(0);
+    writer = std::move(guard);
+  });
+  for (int i = 1; i <= 2; ++i) {
+    mutex.lock_shared().then(
+        [&, i](async_shared_mutex::shared_guard guard) {
+          order.push_back(i);
+          readers.push_back(std::move(guard));
+        });
+  }
+  ASSERT_TRUE(order.empty());
+
+  reader.unlock();
+  ASSERT_EQ(order, (std::vector<int>{0}));
+
+  writer.unlock();
+  ASSERT_EQ(order, (std::vector<int>{0, 1, 2}));
+  ASSERT_FALSE(mutex.try_lock());
+
+  readers.clear();
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(async_shared_mutex_tests, hands_over_to_many_synchronous_waiters) {
+  async_shared_mutex mutex;
+  ASSERT_TRUE(mutex.try_lock());
+
+  std::size_t const count = 100000U;
+  std::size_t resolved = 0U;
+  for (std::size_t i = 0U; i < count; ++i) {
+    mutex.lock().then([&](async_shared_mutex::guard) {
+      ++resolved;
+    });
+  }
+
+  mutex.unlock();
+  ASSERT_EQ(resolved, count);
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(async_shared_mutex_tests, cancels_waiters_on_destruction) {
+  auto mutex = std::make_unique<async_shared_mutex>();
+  ASSERT_TRUE(mutex->try_lock());
+
+  bool canceled = false;
+  mutex->lock_shared()
+      .then([](async_shared_mutex::shared_guard) {
+        FAIL();
+      })
+      .fail([&](cti::exception_t error) {
+        canceled = !bool(error);
+      });
+  ASSERT_FALSE(canceled);
+
+  mutex.reset();
+  ASSERT_TRUE(canceled);
+}
+
+TEST(async_shared_mutex_tests, excludes_writers_from_readers) {
+  constexpr std::size_t threads = 4U;
+  constexpr std::size_t iterations = 2000U;
+
+  async_shared_mutex mutex;
+  std::atomic<std::size_t> readers{0U};
+  std::size_t writes = 0U;
+
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0U; i < threads; ++i) {
+    workers.emplace_back([&, i] {
+      for (std::size_t j = 0U; j < iterations; ++j) {
+        if ((i + j) % 4U == 0U) {
+          mutex.lock()
+              .then([&](async_shared_mutex::guard) {
+                EXPECT_EQ(readers.load(), 0U);
+                ++writes;
+              })
+              .apply(cti::transforms::wait());
+        } else {
+          mutex.lock_shared()
+              .then([&](async_shared_mutex::shared_guard) {
+                ++readers;
+                --readers;
+              })
+              .apply(cti::transforms::wait());
+        }
+      }
+    });
+  }
+
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(writes, threads * iterations / 4U);
+}
@@ -0,0 +1,209 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+#include <test-continuable.hpp>
+
+TEST(thread_pool_tests, executes_work_on_the_pool) {
+  cti::thread_pool pool(2);
+  ASSERT_EQ(pool.size(), 2U);
+
+  auto id = value_of(cti::async_on(
+                         [] {
+                           return std::this_thread::get_id();
+                         },
+                         pool.executor())
+                         .apply(cti::transforms::wait()));
+
+  ASSERT_NE(id, std::this_thread::get_id());
+}
+
+TEST(thread_pool_tests, executes_chained_continuations) {
+  cti::thread_pool pool(4);
+  std::atomic<std::size_t> count{0U};
+
+  std::vector<cti::continuable<>> chains;
+  for (std::size_t i = 0U; i < 64U; ++i) {
+    cti::continuable<> chain = cti::async_on(
+        [&] {
+          ++count;
+        },
+        pool.executor());
+
+    for (std::size_t j = 0U; j < 16U; ++j) {
+      chain = std::move(chain).then(
+          [&] {
+            ++count;
+          },
+          pool.executor());
+    }
+    chains.push_back(std::move(chain));
+  }
+
+  cti::when_all(std::move(chains)).apply(cti::transforms::wait());
+  ASSERT_EQ(count.load(), 64U * 17U);
+  ASSERT_EQ(pool.queue_depth(), 0U);
+}
+
+TEST(thread_pool_tests, accepts_erased_work) {
+  cti::thread_pool pool(1);
+  cti::work work;
+
+  auto chain = cti::async_on(
+      [] {
+        return std::this_thread::get_id();
+      },
+      [&](cti::work erased) {
+        work = std::move(erased);
+      });
+
+  std::promise<std::thread::id> id;
+  std::move(chain).then([&](std::thread::id current) {
+    id.set_value(current);
+  });
+
+  ASSERT_TRUE(work);
+  pool.post(std::move(work));
+
+  auto result = id.get_future();
+  ASSERT_EQ(result.wait_for(std::chrono::seconds(10)),
+            std::future_status::ready);
+  ASSERT_NE(result.get(), std::this_thread::get_id());
+}
+
+TEST(thread_pool_tests, steals_work_from_blocked_threads) {
+  cti::thread_pool pool(2);
+  std::promise<void> stolen;
+  std::promise<void> released;
+
+  cti::async_on(
+      [&] {
+        // The first work is kept in the local slot of the current thread,
+        // until the second one displaces it to the stealable queue.
+        cti::async_on(
+            [&] {
+              stolen.set_value();
+            },
+            pool.executor());
+        cti::async_on([] {}, pool.executor());
+
+        // Block the current thread until the other thread stole the work
+        released.get_future().wait_for(std::chrono::seconds(10));
+      },
+      pool.executor());
+
+  auto status = stolen.get_future().wait_for(std::chrono::seconds(10));
+  released.set_value();
+
+  ASSERT_EQ(status, std::future_status::ready);
+  ASSERT_GE(pool.steals(), 1U);
+}
+
+TEST(thread_pool_tests, takes_over_work_of_blocked_threads) {
+  cti::thread_pool pool(2);
+  std::promise<void> executed;
+  std::promise<void> released;
+
+  cti::async_on(
+      [&] {
+        // The work is kept in the local slot of the current thread,
+        // which blocks before it could execute it.
+        cti::async_on(
+            [&] {
+              executed.set_value();
+            },
+            pool.executor());
+
+        released.get_future().wait_for(std::chrono::seconds(10));
+      },
+      pool.executor());
+
+  auto status = executed.get_future().wait_for(std::chrono::seconds(10));
+  released.set_value();
+
+  ASSERT_EQ(status, std::future_status::ready);
+}
+
+TEST(thread_pool_tests, counts_the_local_slot_as_queued) {
+  cti::thread_pool pool(1);
+
+  std::size_t depth = value_of(cti::async_on(
+                                   [&] {
+                                     cti::async_on([] {}, pool.executor());
+                                     return pool.queue_depth();
+                                   },
+                                   pool.executor())
+                                   .apply(cti::transforms::wait()));
+
+  ASSERT_EQ(depth, 1U);
+}
+
+TEST(thread_pool_tests, completes_outstanding_work_on_destruction) {
+  std::atomic<std::size_t> count{0U};
+
+  {
+    cti::thread_pool pool(3);
+    for (std::size_t i = 0U; i < 100U; ++i) {
+      cti::async_on(
+          [&] {
+            ++count;
+          },
+          pool.executor());
+    }
+  }
+
+  ASSERT_EQ(count.load(), 100U);
+}
+
+TEST(thread_pool_tests, bounds_concurrent_loops_on_the_pool) {
+  cti::thread_pool pool(4);
+  std::atomic<std::size_t> running{0U};
+  std::atomic<std::size_t> max_running{0U};
+  std::atomic<std::size_t> count{0U};
+
+  cti::for_each_concurrent(
+      [&](std::size_t) {
+        return cti::async_on(
+            [&] {
+              std::size_t const current = ++running;
+              std::size_t expected = max_running.load();
+              while ((current > expected) &&
+                     !max_running.compare_exchange_weak(expected, current)) {
+              }
+
+              ++count;
+              --running;
+            },
+            pool.executor());
+      },
+      std::size_t(0U), std::size_t(10000U), 3U)
+      .apply(cti::transforms::wait());
+
+  ASSERT_EQ(count.load(), 10000U);
+  ASSERT_LE(max_running.load(), 3U);
+}
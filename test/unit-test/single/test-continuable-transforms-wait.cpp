@@ -0,0 +1,152 @@
+
+/*
+  Copyright(c) 2015 - 2022 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <test-continuable.hpp>
+
+using namespace std::chrono_literals;
+
+TEST(wait_transform_tests, waits_for_results_of_other_threads) {
+  cti::thread_pool pool(2);
+
+  for (int i = 0; i < 10000; ++i) {
+    int const value = value_of(cti::async_on(
+                                   [i] {
+                                     return i;
+                                   },
+                                   pool.executor())
+                                   .apply(cti::transforms::wait()));
+    ASSERT_EQ(value, i);
+  }
+}
+
+TEST(wait_transform_tests, parks_until_the_result_arrives) {
+  cti::promise<int> promise;
+  std::thread resolver;
+
+  int const value = value_of(cti::make_continuable<int>([&](auto&& p) {
+                               promise = std::forward<decltype(p)>(p);
+                               resolver = std::thread([&] {
+                                 // Exceed the spin phase of the waiting thread
+                                 std::this_thread::sleep_for(20ms);
+                                 promise.set_value(3746);
+                               });
+                             }).apply(cti::transforms::wait()));
+
+  resolver.join();
+  ASSERT_EQ(value, 3746);
+}
+
+TEST(wait_transform_tests, wait_for_returns_the_result_of_other_threads) {
+  cti::thread_pool pool(1);
+
+  auto result = cti::async_on(
+                    [] {
+                      std::this_thread::sleep_for(5ms);
+                      return 47463;
+                    },
+                    pool.executor())
+                    .apply(cti::transforms::wait_for(24h));
+
+  ASSERT_TRUE(result.is_value());
+  ASSERT_EQ(result.get_value(), 47463);
+}
+
+TEST(wait_transform_tests, wait_until_drops_results_arriving_after_timeout) {
+  cti::promise<int> promise;
+
+  auto result = cti::make_continuable<int>([&](auto&& p) {
+                  promise = std::forward<decltype(p)>(p);
+                }).apply(cti::transforms::wait_until(
+                    std::chrono::system_clock::now() + 10ms));
+
+  ASSERT_TRUE(result.is_empty());
+
+  // The late result is dropped without touching the stack of the waiter
+  std::thread resolver([&] {
+    promise.set_value(36354);
+  });
+  resolver.join();
+}
+
+TEST(wait_transform_tests, wait_all_returns_all_results) {
+  cti::thread_pool pool(2);
+
+  std::vector<cti::continuable<int>> continuables;
+  for (int i = 0; i < 1000; ++i) {
+    continuables.push_back(cti::async_on(
+        [i] {
+          return i;
+        },
+        pool.executor()));
+  }
+  continuables.push_back(
+      cti::make_exceptional_continuable<int>(supply_test_exception()));
+  continuables.push_back(cti::make_continuable<int>([](auto&&) {
+    // The promise is dropped without being resolved
+  }));
+
+  std::vector<cti::result<int>> results =
+      cti::transforms::wait_all(std::move(continuables));
+
+  ASSERT_EQ(results.size(), 1002U);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(results[i].is_value());
+    ASSERT_EQ(results[i].get_value(), i);
+  }
+  ASSERT_TRUE(results[1000].is_exception());
+  ASSERT_TRUE(results[1001].is_empty());
+}
+
+TEST(wait_transform_tests, wait_all_accepts_empty_ranges) {
+  std::vector<cti::continuable<>> continuables;
+  ASSERT_TRUE(cti::transforms::wait_all(continuables.begin(),
+                                        continuables.end())
+                  .empty());
+}
+
+TEST(wait_transform_tests, wait_any_returns_the_first_result) {
+  cti::promise<int> remaining;
+
+  std::vector<cti::continuable<int>> continuables;
+  continuables.push_back(cti::make_continuable<int>([&](auto&& promise) {
+    remaining = std::forward<decltype(promise)>(promise);
+  }));
+  continuables.push_back(cti::make_ready_continuable(36354));
+
+  std::vector<cti::result<int>> results =
+      cti::transforms::wait_any(continuables.begin(), continuables.end());
+
+  ASSERT_EQ(results.size(), 2U);
+  ASSERT_TRUE(results[0].is_empty());
+  ASSERT_EQ(results[1].get_value(), 36354);
+
+  // The remaining continuables are cancelled and their results are dropped
+  ASSERT_TRUE(remaining.is_cancelled());
+  std::thread resolver([&] {
+    remaining.set_value(47463);
+  });
+  resolver.join();
+}
@@ -106,6 +106,17 @@ inline auto empty_continuable() {
   return cti::make_continuable<void>(empty_caller());
 }
 
+/// Returns the value of a synchronous wait, which returns the result
+/// itself when exceptions are disabled.
+template <typename... T>
+auto value_of(cti::result<T...>&& result) {
+  return std::move(result).get_value();
+}
+template <typename T>
+T value_of(T&& value) {
+  return std::forward<T>(value);
+}
+
 struct provide_copyable {
   template <typename... Args, typename... Hint, typename T>
   auto make(identity<Args...>, identity<Hint...>, T&& callback) {